@@ -0,0 +1,88 @@
+#include "checkpoint/checkpoint.h"
+
+#include <fmt/format.h>
+
+#include <cstring>
+
+#include "Vtb_triathlon.h"
+#include "checkpoint/serialize.h"
+#include "device/device.h"
+#include "difftest/difftest.h"
+#include "logger/logger.h"
+#include "mem/mem_system.h"
+
+namespace {
+constexpr char kMagic[8] = {'n', 'p', 'c', 'c', 'k', 'p', 't', '\0'};
+constexpr uint32_t kVersion = 2;
+}  // namespace
+
+#ifdef NPC_SAVABLE
+bool save_checkpoint(const std::string &path, const CheckpointTargets &t,
+                     const SimState &st) {
+  VerilatedSave os;
+  os.open(path.c_str());
+  if (!os.isOpen()) {
+    Logger::log_warn(fmt::format("[ckpt] cannot write {}", path));
+    return false;
+  }
+  os.write(kMagic, sizeof(kMagic));
+  ckpt_put(os, kVersion);
+  ckpt_put(os, st);
+  os << *t.top;
+  t.mem->save(os);
+  t.serial->save(os);
+  t.rtc->save(os);
+  t.difftest->save(os);
+  os.close();
+  Logger::log_info(
+      fmt::format("[ckpt] saved cycle={} to {}", st.cycles, path));
+  return true;
+}
+
+bool restore_checkpoint(const std::string &path, const CheckpointTargets &t,
+                        SimState &st) {
+  VerilatedRestore is;
+  is.open(path.c_str());
+  if (!is.isOpen()) {
+    Logger::log_warn(fmt::format("[ckpt] cannot read {}", path));
+    return false;
+  }
+  char magic[sizeof(kMagic)] = {};
+  uint32_t version = 0;
+  is.read(magic, sizeof(magic));
+  ckpt_get(is, version);
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion) {
+    Logger::log_warn(fmt::format("[ckpt] {} is not a v{} npc checkpoint", path,
+                                 kVersion));
+    return false;
+  }
+  ckpt_get(is, st);
+  is >> *t.top;
+  t.mem->restore(is);
+  t.serial->restore(is);
+  t.rtc->restore(is);
+  bool ok = t.difftest->restore(is, t.mem->mem);
+  is.close();
+  if (!ok) return false;
+  Logger::log_info(
+      fmt::format("[ckpt] restored cycle={} from {}", st.cycles, path));
+  return true;
+}
+#else
+// Threaded builds (THREADS>1) cannot use --savable, so the model has no
+// serialiser.
+bool save_checkpoint(const std::string &path, const CheckpointTargets &,
+                     const SimState &) {
+  Logger::log_warn(
+      fmt::format("[ckpt] {} skipped: model built without --savable", path));
+  return false;
+}
+
+bool restore_checkpoint(const std::string &path, const CheckpointTargets &,
+                        SimState &) {
+  Logger::log_warn(
+      fmt::format("[ckpt] cannot restore {}: model built without --savable",
+                  path));
+  return false;
+}
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+struct Vtb_triathlon;
+struct MemSystem;
+class SerialDevice;
+class RtcDevice;
+class Difftest;
+
+// Main-loop state that has to survive a restore.
+struct SimState {
+  uint64_t cycles = 0;  // next cycle to simulate
+  uint64_t sim_time = 0;
+  uint64_t total_commits = 0;
+  uint64_t no_commit_cycles = 0;
+  uint32_t last_commit_pc = 0;
+  uint32_t last_commit_inst = 0;
+  std::array<uint32_t, 32> rf{};
+};
+
+// Everything a checkpoint covers besides SimState.
+struct CheckpointTargets {
+  Vtb_triathlon *top = nullptr;
+  MemSystem *mem = nullptr;
+  SerialDevice *serial = nullptr;
+  RtcDevice *rtc = nullptr;
+  Difftest *difftest = nullptr;
+};
+
+// One file: a harness header, the Verilator model (VerilatedSave, needs
+// --savable) and then the harness state. Checkpoints are taken between
+// cycles, after the retire group has been checked.
+bool save_checkpoint(const std::string &path, const CheckpointTargets &t,
+                     const SimState &st);
+bool restore_checkpoint(const std::string &path, const CheckpointTargets &t,
+                        SimState &st);
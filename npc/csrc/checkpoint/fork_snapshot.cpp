@@ -0,0 +1,118 @@
+#include "checkpoint/fork_snapshot.h"
+
+#include <fmt/format.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+
+#include "logger/logger.h"
+
+bool ForkSnapshots::configure(uint64_t every, uint64_t keep) {
+#ifdef NPC_SAVABLE
+  every_ = every;
+  keep_ = keep ? keep : 1;
+  return true;
+#else
+  (void)every;
+  (void)keep;
+  Logger::log_warn(
+      "[fork  ] snapshots need a single-threaded model (THREADS=1)");
+  return false;
+#endif
+}
+
+bool ForkSnapshots::take(uint64_t cycle, uint64_t &until) {
+  // Buffered output would otherwise be written again by the child.
+  std::fflush(stdout);
+  std::fflush(stderr);
+  int fds[2];
+  if (pipe(fds) != 0) {
+    Logger::log_warn(fmt::format("[fork  ] pipe failed at cycle={}", cycle));
+    return false;
+  }
+  pid_t parent = getpid();
+  pid_t pid = fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    Logger::log_warn(fmt::format("[fork  ] fork failed at cycle={}", cycle));
+    return false;
+  }
+  if (pid > 0) {
+    close(fds[0]);
+    children_.push_back({pid, fds[1], cycle});
+    while (children_.size() > keep_) {
+      discard(children_.front());
+      children_.pop_front();
+    }
+    return false;
+  }
+
+  // Snapshot: wait for a wake-up, or EOF when the parent discards us or
+  // exits.
+  close(fds[1]);
+  for (const Child &c : children_) close(c.fd);
+  children_.clear();
+  prctl(PR_SET_PDEATHSIG, SIGKILL);
+  if (getppid() != parent) _exit(0);
+  uint64_t cmd = 0;
+  ssize_t n = read(fds[0], &cmd, sizeof(cmd));
+  close(fds[0]);
+  if (n != static_cast<ssize_t>(sizeof(cmd))) _exit(0);
+  every_ = 0;
+  until = cmd;
+  return true;
+}
+
+bool ForkSnapshots::replay(uint64_t cycle) {
+  // Newest snapshot taken before the failing cycle.
+  while (!children_.empty() && children_.back().cycle >= cycle) {
+    discard(children_.back());
+    children_.pop_back();
+  }
+  if (children_.empty()) return false;
+  Child c = children_.back();
+  children_.pop_back();
+  Logger::log_info(fmt::format(
+      "[fork  ] failure at cycle={}, replaying from cycle={} (pid {})", cycle,
+      c.cycle, c.pid));
+  return wake(c, cycle);
+}
+
+bool ForkSnapshots::resume(uint64_t cycle, uint64_t cmd, uint64_t &from) {
+  if (children_.empty()) return false;
+  while (children_.size() > 1 && children_.back().cycle > cycle) {
+    discard(children_.back());
+    children_.pop_back();
+  }
+  Child c = children_.back();
+  children_.pop_back();
+  from = c.cycle;
+  return wake(c, cmd);
+}
+
+// Hands `cmd` to a snapshot taken off the list, waits for it to finish and
+// drops the others.
+bool ForkSnapshots::wake(const Child &c, uint64_t cmd) {
+  std::fflush(stdout);
+  bool ok =
+      write(c.fd, &cmd, sizeof(cmd)) == static_cast<ssize_t>(sizeof(cmd));
+  close(c.fd);
+  int status = 0;
+  waitpid(c.pid, &status, 0);
+  discard_all();
+  return ok;
+}
+
+void ForkSnapshots::discard(const Child &c) {
+  close(c.fd);
+  waitpid(c.pid, nullptr, 0);
+}
+
+void ForkSnapshots::discard_all() {
+  for (const Child &c : children_) discard(c);
+  children_.clear();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <deque>
+
+// Copy-on-write snapshots for --fork-snapshot-every. Every `every` cycles
+// the simulator fork()s; the child blocks on a pipe and costs nothing but
+// the pages the parent dirties afterwards. The newest `keep` children are
+// kept. When a run fails, the newest child is resumed with the failure
+// cycle and replays up to it with full tracing, while the parent waits.
+// The wave tracer keeps its own two-entry ring for --trace-pre.
+//
+// Verilator's thread pool does not survive fork(), so this needs a
+// single-threaded model (THREADS=1).
+class ForkSnapshots {
+ public:
+  ~ForkSnapshots() { discard_all(); }
+
+  bool configure(uint64_t every, uint64_t keep);
+  bool enabled() const { return every_ != 0; }
+  bool due(uint64_t cycle) const { return every_ && cycle % every_ == 0; }
+
+  // Forks at `cycle`, the next cycle to simulate. Returns true only in a
+  // resumed child, with `until` set to the cycle the parent failed at.
+  bool take(uint64_t cycle, uint64_t &until);
+  // Resumes the newest snapshot older than `cycle` to replay up to it and
+  // waits for it. Returns false if there is none.
+  bool replay(uint64_t cycle);
+  // Resumes the newest snapshot taken at or before `cycle`, else the oldest,
+  // with `cmd` as its `until`, and waits for it. Returns the cycle the
+  // snapshot was taken at in `from`; false if there is none.
+  bool resume(uint64_t cycle, uint64_t cmd, uint64_t &from);
+  void discard_all();
+
+ private:
+  struct Child {
+    pid_t pid;
+    int fd;  // write end of the wake-up pipe
+    uint64_t cycle;
+  };
+
+  bool wake(const Child &c, uint64_t cmd);
+  void discard(const Child &c);
+
+  uint64_t every_ = 0;
+  uint64_t keep_ = 0;
+  std::deque<Child> children_;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <type_traits>
+
+#include "verilated_save.h"
+
+// Raw (de)serialisation of trivially copyable harness state into the same
+// stream VerilatedSave/VerilatedRestore use for the model, so a checkpoint
+// is a single file.
+template <typename T>
+void ckpt_put(VerilatedSerialize &os, const T &v) {
+  static_assert(std::is_trivially_copyable<T>::value, "POD only");
+  os.write(&v, sizeof(T));
+}
+
+template <typename T>
+void ckpt_get(VerilatedDeserialize &is, T &v) {
+  static_assert(std::is_trivially_copyable<T>::value, "POD only");
+  is.read(&v, sizeof(T));
+}
@@ -0,0 +1,257 @@
+#include "debug/debugger.h"
+
+#include <fmt/format.h>
+#include <readline/history.h>
+#include <readline/readline.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "Vtb_triathlon.h"
+#include "checkpoint/checkpoint.h"
+#include "difftest/difftest.h"
+#include "logger/logger.h"
+#include "logger/snapshot.h"
+#include "mem/unified_mem.h"
+#include "trace/wave.h"
+
+volatile std::sig_atomic_t Debugger::interrupted_ = 0;
+
+namespace {
+const char *const kHelp =
+    "c                     continue until a breakpoint (Ctrl-C stops)\n"
+    "si [N]                run N cycles (default 1)\n"
+    "until ADDR            run until an instruction at ADDR retires\n"
+    "b pc ADDR             break when an instruction at ADDR retires\n"
+    "b flush | b mispred   break on a backend flush / BRU mispredict\n"
+    "b store ADDR          break when a store to ADDR leaves the SB\n"
+    "d pc ADDR | d store ADDR | d flush | d mispred | d all\n"
+    "info r                architectural registers\n"
+    "info b                breakpoints\n"
+    "info s fe|bru|rob|lsu|perf   model outputs of a snapshot group\n"
+    "x N ADDR              N words of guest memory from ADDR\n"
+    "wave on [FILE] | wave off    start / pause waveform dumping\n"
+    "q                     quit";
+
+struct Group {
+  const char *name;
+  SnapshotPart part;
+};
+const Group kGroups[] = {{"fe", kSnapFrontend},
+                         {"bru", kSnapBru},
+                         {"rob", kSnapRob},
+                         {"lsu", kSnapLsu},
+                         {"perf", kSnapPerf}};
+
+bool parse_num(const std::string &s, uint64_t &out) {
+  try {
+    size_t idx = 0;
+    out = std::stoull(s, &idx, 0);
+    return idx == s.size();
+  } catch (...) {
+    return false;
+  }
+}
+}  // namespace
+
+void Debugger::enable() {
+  enabled_ = true;
+  std::signal(SIGINT, [](int) { interrupted_ = 1; });
+}
+
+bool Debugger::check(const Vtb_triathlon *top, uint64_t next_cycle) {
+  if (commit_hit_) {
+    stop_reason_ = fmt::format("{} pc={:#010x}",
+                               hit_pc_ == until_pc_ ? "until" : "breakpoint",
+                               hit_pc_);
+  } else if (break_flush_ && top->backend_flush_o) {
+    stop_reason_ =
+        fmt::format("flush redirect={:#010x}",
+                    static_cast<uint32_t>(top->backend_redirect_pc_o));
+  } else if (break_mispred_ && top->dbg_bru_valid_o && top->dbg_bru_mispred_o) {
+    stop_reason_ = fmt::format("mispredict pc={:#010x}",
+                               static_cast<uint32_t>(top->dbg_bru_pc_o));
+  } else if (!store_breaks_.empty() && top->dbg_sb_dcache_req_valid_o &&
+             top->dbg_sb_dcache_req_ready_o &&
+             store_breaks_.count(top->dbg_sb_dcache_req_addr_o & ~0x3u)) {
+    stop_reason_ = fmt::format(
+        "store addr={:#010x} data={:#010x}",
+        static_cast<uint32_t>(top->dbg_sb_dcache_req_addr_o),
+        static_cast<uint32_t>(top->dbg_sb_dcache_req_data_o));
+  } else if (interrupted_) {
+    stop_reason_ = "interrupted";
+  } else if (next_cycle >= stop_at_) {
+    stop_reason_.clear();
+  } else {
+    return false;
+  }
+  commit_hit_ = false;
+  until_pc_ = kNoPc;
+  return true;
+}
+
+void Debugger::report_stop(const Context &ctx) {
+  const SimState &st = *ctx.st;
+  Logger::log_info(fmt::format(
+      "[sdb   ] cycle={} commits={} last_pc={:#010x}{}{}", st.cycles,
+      st.total_commits, st.last_commit_pc, stop_reason_.empty() ? "" : " ",
+      stop_reason_));
+  stop_reason_.clear();
+}
+
+bool Debugger::prompt(const Context &ctx) {
+  report_stop(ctx);
+  for (;;) {
+    char *raw = readline("(npc) ");
+    if (!raw) return false;
+    std::string line = raw;
+    std::free(raw);
+    if (line.empty()) {
+      line = last_line_;
+    } else {
+      add_history(line.c_str());
+      last_line_ = line;
+    }
+    bool resume = false;
+    if (!execute(ctx, line, resume)) return false;
+    if (resume) {
+      interrupted_ = 0;
+      return true;
+    }
+  }
+}
+
+// Returns false to quit; `resume` is set by the commands that run.
+bool Debugger::execute(const Context &ctx, const std::string &line,
+                       bool &resume) {
+  std::istringstream in(line);
+  std::vector<std::string> w;
+  for (std::string t; in >> t;) w.push_back(t);
+  if (w.empty()) return true;
+  const std::string &cmd = w[0];
+  uint64_t n = 0;
+  uint64_t addr = 0;
+  uint64_t now = ctx.st->cycles;
+
+  if (cmd == "q") return false;
+  if (cmd == "help") {
+    Logger::log_info(kHelp);
+  } else if (cmd == "c") {
+    stop_at_ = std::numeric_limits<uint64_t>::max();
+    resume = true;
+  } else if (cmd == "si") {
+    n = 1;
+    if (w.size() > 1 && !parse_num(w[1], n)) {
+      Logger::log_info("usage: si [N]");
+      return true;
+    }
+    stop_at_ = now + std::max<uint64_t>(n, 1);
+    resume = true;
+  } else if (cmd == "until" && w.size() == 2 && parse_num(w[1], addr)) {
+    until_pc_ = static_cast<uint32_t>(addr);
+    stop_at_ = std::numeric_limits<uint64_t>::max();
+    resume = true;
+  } else if ((cmd == "b" || cmd == "d") && w.size() >= 2) {
+    bool set = cmd == "b";
+    const std::string &what = w[1];
+    if (what == "flush") {
+      break_flush_ = set;
+    } else if (what == "mispred") {
+      break_mispred_ = set;
+    } else if (what == "all" && !set) {
+      break_flush_ = break_mispred_ = false;
+      pc_breaks_.clear();
+      store_breaks_.clear();
+    } else if ((what == "pc" || what == "store") && w.size() == 3 &&
+               parse_num(w[2], addr)) {
+      auto &breaks = what == "pc" ? pc_breaks_ : store_breaks_;
+      uint32_t key = static_cast<uint32_t>(addr);
+      if (what == "store") key &= ~0x3u;
+      if (set) {
+        breaks.insert(key);
+      } else {
+        breaks.erase(key);
+      }
+    } else {
+      Logger::log_info("usage: b|d pc ADDR | store ADDR | flush | mispred");
+    }
+  } else if (cmd == "info" && w.size() >= 2) {
+    info(ctx, w.size() > 2 ? w[1] + " " + w[2] : w[1]);
+  } else if (cmd == "x" && w.size() == 3 && parse_num(w[1], n) &&
+             parse_num(w[2], addr)) {
+    uint32_t base = static_cast<uint32_t>(addr) & ~0x3u;
+    for (uint64_t i = 0; i < n; i += 4) {
+      std::string row = fmt::format("{:#010x}:", base + 4 * i);
+      for (uint64_t j = i; j < std::min<uint64_t>(n, i + 4); j++) {
+        uint32_t a = static_cast<uint32_t>(base + 4 * j);
+        row += fmt::format(" {:#010x}", ctx.mem->read_word(a));
+      }
+      Logger::log_info(row);
+    }
+  } else if (cmd == "wave" && w.size() >= 2 && w[1] == "on") {
+    if (ctx.wave->is_open() &&
+        ctx.wave->config().trigger != WaveConfig::Trigger::kNone) {
+      Logger::log_info("wave: the window is owned by --wave-trigger");
+      return true;
+    }
+    if (!ctx.wave->is_open()) {
+      WaveConfig cfg;
+      cfg.enabled = true;
+      if (w.size() > 2) cfg.path = w[2];
+      cfg.start = now;
+      if (!ctx.wave->open(ctx.top, cfg)) return true;
+    }
+    ctx.wave->set_window(now, std::numeric_limits<uint64_t>::max());
+    Logger::log_info(fmt::format("[sdb   ] dumping {} from cycle {}",
+                                 ctx.wave->config().path, now));
+  } else if (cmd == "wave" && w.size() == 2 && w[1] == "off") {
+    if (ctx.wave->is_open() &&
+        ctx.wave->config().trigger == WaveConfig::Trigger::kNone) {
+      ctx.wave->set_window(now, now);
+    }
+  } else {
+    Logger::log_info(fmt::format("unknown command: {} (try help)", line));
+  }
+  return true;
+}
+
+void Debugger::info(const Context &ctx, const std::string &what) {
+  if (what == "r") {
+    const SimState &st = *ctx.st;
+    for (int r = 0; r < kNumGprs; r += 4) {
+      Logger::log_info(fmt::format(
+          "x{:<2} {:#010x}  x{:<2} {:#010x}  x{:<2} {:#010x}  x{:<2} {:#010x}",
+          r, st.rf[r], r + 1, st.rf[r + 1], r + 2, st.rf[r + 2], r + 3,
+          st.rf[r + 3]));
+    }
+    return;
+  }
+  if (what == "b") {
+    list_breakpoints();
+    return;
+  }
+  for (const Group &g : kGroups) {
+    if (what != std::string("s ") + g.name) continue;
+    Snapshot snap{};
+    collect_parts(ctx.top, g.part, snap);
+    for_each_field(snap, g.part, [](const char *name, uint64_t value) {
+      Logger::log_info(fmt::format("  {:<28} {:#x}", name, value));
+    });
+    return;
+  }
+  Logger::log_info("usage: info r | info b | info s fe|bru|rob|lsu|perf");
+}
+
+void Debugger::list_breakpoints() const {
+  if (break_flush_) Logger::log_info("  flush");
+  if (break_mispred_) Logger::log_info("  mispred");
+  for (uint32_t pc : pc_breaks_) {
+    Logger::log_info(fmt::format("  pc {:#010x}", pc));
+  }
+  for (uint32_t addr : store_breaks_) {
+    Logger::log_info(fmt::format("  store {:#010x}", addr));
+  }
+}
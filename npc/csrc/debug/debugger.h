@@ -0,0 +1,69 @@
+#pragma once
+
+#include <csignal>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_set>
+
+struct Vtb_triathlon;
+struct SimState;
+struct UnifiedMem;
+class WaveTracer;
+
+// Command loop for --interactive, after NEMU's sdb. The simulation runs
+// between prompts; while it runs, the stop conditions cost a few flag tests
+// and at most two hash lookups per cycle, so `c` runs close to full speed.
+// Ctrl-C stops a running command at the end of the current cycle.
+class Debugger {
+ public:
+  // What the commands inspect; owned by the caller.
+  struct Context {
+    Vtb_triathlon *top = nullptr;
+    SimState *st = nullptr;
+    UnifiedMem *mem = nullptr;
+    WaveTracer *wave = nullptr;
+  };
+
+  void enable();
+  bool enabled() const { return enabled_; }
+
+  // A retired instruction at `pc`.
+  void commit(uint32_t pc) {
+    if (pc == until_pc_ || (!pc_breaks_.empty() && pc_breaks_.count(pc))) {
+      commit_hit_ = true;
+      hit_pc_ = pc;
+    }
+  }
+  // End of cycle; `next_cycle` is the next cycle to simulate. True when the
+  // run should stop and prompt.
+  bool check(const Vtb_triathlon *top, uint64_t next_cycle);
+
+  // Reads commands until one resumes the simulation. Returns false on `q`
+  // or end of input.
+  bool prompt(const Context &ctx);
+
+ private:
+  static constexpr uint64_t kNoPc = std::numeric_limits<uint64_t>::max();
+
+  bool execute(const Context &ctx, const std::string &line, bool &resume);
+  void report_stop(const Context &ctx);
+  void info(const Context &ctx, const std::string &what);
+  void list_breakpoints() const;
+
+  bool enabled_ = false;
+  uint64_t stop_at_ = 0;
+  uint64_t until_pc_ = kNoPc;
+  bool break_flush_ = false;
+  bool break_mispred_ = false;
+  std::unordered_set<uint32_t> pc_breaks_;
+  // Word addresses; a store matches if it writes into the word.
+  std::unordered_set<uint32_t> store_breaks_;
+  std::string last_line_;
+
+  bool commit_hit_ = false;
+  uint32_t hit_pc_ = 0;
+  std::string stop_reason_;
+
+  static volatile std::sig_atomic_t interrupted_;
+};
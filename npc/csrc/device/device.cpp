@@ -0,0 +1,131 @@
+#include "device/device.h"
+
+#include <fmt/format.h>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "checkpoint/serialize.h"
+#include "logger/logger.h"
+
+namespace {
+constexpr uint32_t kLsrDataReady = 1u << 0;
+constexpr uint32_t kLsrThrEmpty = 1u << 5;
+constexpr uint32_t kLsrTxEmpty = 1u << 6;
+}  // namespace
+
+void DeviceBus::add_map(MmioMap map) { maps_.push_back(std::move(map)); }
+
+const MmioMap *DeviceBus::find(uint32_t addr) const {
+  for (const auto &map : maps_) {
+    if (addr - map.base < map.size) return &map;
+  }
+  return nullptr;
+}
+
+uint32_t DeviceBus::read(uint32_t addr) {
+  const MmioMap *map = find(addr);
+  if (!map || !map->read) {
+    Logger::log_warn(fmt::format("[device] unmapped read 0x{:08x}", addr));
+    return 0;
+  }
+  return map->read((addr - map->base) & ~3u);
+}
+
+void DeviceBus::write(uint32_t addr, uint32_t data) {
+  const MmioMap *map = find(addr);
+  if (!map || !map->write) {
+    Logger::log_warn(fmt::format("[device] unmapped write 0x{:08x}=0x{:x}",
+                                 addr, data));
+    return;
+  }
+  map->write((addr - map->base) & ~3u, data);
+}
+
+bool SerialDevice::load_input(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    Logger::log_warn(fmt::format("[device] cannot open serial input {}", path));
+    return false;
+  }
+  rx_.assign(std::istreambuf_iterator<char>(in),
+             std::istreambuf_iterator<char>());
+  return true;
+}
+
+void SerialDevice::attach(DeviceBus &bus) {
+  bus.add_map({"serial", kBase, kSize,
+               [this](uint32_t offset) { return read(offset); },
+               [this](uint32_t offset, uint32_t data) { write(offset, data); }});
+}
+
+void SerialDevice::flush() {
+  if (tx_.empty()) return;
+  if (!quiet_) std::cout << tx_ << std::flush;
+  tx_.clear();
+}
+
+void SerialDevice::save(VerilatedSerialize &os) const {
+  uint64_t tx_len = tx_.size();
+  uint64_t rx_len = rx_.size();
+  ckpt_put(os, tx_len);
+  os.write(tx_.data(), tx_.size());
+  ckpt_put(os, rx_len);
+  for (uint8_t ch : rx_) ckpt_put(os, ch);
+}
+
+void SerialDevice::restore(VerilatedDeserialize &is) {
+  uint64_t tx_len = 0;
+  uint64_t rx_len = 0;
+  ckpt_get(is, tx_len);
+  tx_.resize(tx_len);
+  is.read(tx_.data(), tx_len);
+  ckpt_get(is, rx_len);
+  rx_.resize(rx_len);
+  for (uint8_t &ch : rx_) ckpt_get(is, ch);
+}
+
+uint32_t SerialDevice::read(uint32_t offset) {
+  if (offset == 0) {
+    if (rx_.empty()) return 0;
+    uint8_t ch = rx_.front();
+    rx_.pop_front();
+    return ch;
+  }
+  // LSR sits in byte lane 1 of the word at +4.
+  uint32_t lsr = kLsrThrEmpty | kLsrTxEmpty;
+  if (!rx_.empty()) lsr |= kLsrDataReady;
+  return lsr << 8;
+}
+
+void SerialDevice::write(uint32_t offset, uint32_t data) {
+  if (offset != 0) return;
+  char ch = static_cast<char>(data & 0xFFu);
+  tx_.push_back(ch);
+  if (ch == '\n') flush();
+}
+
+RtcDevice::RtcDevice(const uint64_t *cycle, uint32_t core_freq_mhz)
+    : cycle_(cycle), core_freq_mhz_(core_freq_mhz ? core_freq_mhz : 1) {}
+
+uint64_t RtcDevice::uptime_us() const { return *cycle_ / core_freq_mhz_; }
+
+void RtcDevice::attach(DeviceBus &bus) {
+  bus.add_map({"rtc", kBase, kSize,
+               [this](uint32_t offset) { return read(offset); }, nullptr});
+}
+
+void RtcDevice::save(VerilatedSerialize &os) const {
+  ckpt_put(os, latched_);
+}
+
+void RtcDevice::restore(VerilatedDeserialize &is) { ckpt_get(is, latched_); }
+
+uint32_t RtcDevice::read(uint32_t offset) {
+  if (offset == 0) {
+    latched_ = uptime_us();
+    return static_cast<uint32_t>(latched_);
+  }
+  return static_cast<uint32_t>(latched_ >> 32);
+}
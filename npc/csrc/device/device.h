@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+class VerilatedSerialize;
+class VerilatedDeserialize;
+
+// One register window on the device bus. Handlers get the word-aligned
+// offset from `base`; data is a 32-bit word with sub-word accesses in their
+// byte lane (the D$ sends stores as a one-word line without strobes).
+struct MmioMap {
+  std::string name;
+  uint32_t base = 0;
+  uint32_t size = 0;
+  // Reads may have side effects (FIFO pops, latches).
+  std::function<uint32_t(uint32_t offset)> read;
+  std::function<void(uint32_t offset, uint32_t data)> write;
+};
+
+// Address decode for the uncached device region of the D$
+// (vsrc/cache/dcache.sv, MMIO_REGION).
+class DeviceBus {
+ public:
+  static constexpr uint32_t kMmioBase = 0xa0000000u;
+  static constexpr uint32_t kMmioSize = 0x10000000u;
+  // Device registers answer in a fixed number of cycles.
+  static constexpr uint64_t kLatency = 2;
+
+  static bool in_mmio(uint32_t addr) { return addr - kMmioBase < kMmioSize; }
+
+  void add_map(MmioMap map);
+  const MmioMap *find(uint32_t addr) const;
+
+  // Unmapped addresses read as 0 and drop writes, with a warning.
+  uint32_t read(uint32_t addr);
+  void write(uint32_t addr, uint32_t data);
+
+ private:
+  std::vector<MmioMap> maps_;
+};
+
+// NS16550-style serial at AM's SERIAL_PORT: THR/RBR at +0, LSR at +5.
+// Output is line buffered; input is served from a file loaded up front.
+class SerialDevice {
+ public:
+  static constexpr uint32_t kBase = 0xa00003f8u;
+  static constexpr uint32_t kSize = 8;
+
+  bool load_input(const std::string &path);
+  void attach(DeviceBus &bus);
+  void flush();
+  // Drop output instead of printing it, e.g. while replaying cycles whose
+  // output has already been shown.
+  void set_quiet(bool quiet) { quiet_ = quiet; }
+  void save(VerilatedSerialize &os) const;
+  void restore(VerilatedDeserialize &is);
+
+ private:
+  uint32_t read(uint32_t offset);
+  void write(uint32_t offset, uint32_t data);
+
+  bool quiet_ = false;
+  std::string tx_;
+  std::deque<uint8_t> rx_;
+};
+
+// AM RTC_ADDR: 64-bit microsecond uptime derived from the simulated cycle
+// count. Reading the low word latches the value the high word returns, so
+// the low-then-high read in abstract-machine's timer.c is consistent.
+class RtcDevice {
+ public:
+  static constexpr uint32_t kBase = 0xa0000048u;
+  static constexpr uint32_t kSize = 8;
+
+  RtcDevice(const uint64_t *cycle, uint32_t core_freq_mhz);
+
+  uint64_t uptime_us() const;
+  void attach(DeviceBus &bus);
+  void save(VerilatedSerialize &os) const;
+  void restore(VerilatedDeserialize &is);
+
+ private:
+  uint32_t read(uint32_t offset);
+
+  const uint64_t *cycle_;
+  uint32_t core_freq_mhz_;
+  uint64_t latched_ = 0;
+};
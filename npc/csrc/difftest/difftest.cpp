@@ -0,0 +1,181 @@
+#include "difftest/difftest.h"
+
+#include <dlfcn.h>
+#include <fmt/format.h>
+
+#include "checkpoint/serialize.h"
+#include "logger/logger.h"
+#include "mem/unified_mem.h"
+
+namespace {
+// nemu/include/difftest-def.h
+constexpr bool kToDut = false;
+constexpr bool kToRef = true;
+
+constexpr uint32_t kOpLoad = 0x03;
+constexpr uint32_t kOpStore = 0x23;
+
+// Loads/stores whose effective address leaves pmem hit devices that only
+// exist on the DUT side, so the REF must not execute them.
+bool is_mmio_access(uint32_t inst, const Difftest::RegFile &rf) {
+  uint32_t opcode = inst & 0x7Fu;
+  if (opcode != kOpLoad && opcode != kOpStore) return false;
+  uint32_t rs1 = (inst >> 15) & 0x1Fu;
+  int32_t imm = 0;
+  if (opcode == kOpLoad) {
+    imm = static_cast<int32_t>(inst) >> 20;
+  } else {
+    imm = ((static_cast<int32_t>(inst) >> 25) << 5) |
+          static_cast<int32_t>((inst >> 7) & 0x1Fu);
+  }
+  uint32_t addr = rf[rs1] + static_cast<uint32_t>(imm);
+  return !UnifiedMem::in_pmem(addr);
+}
+}  // namespace
+
+bool Difftest::init(const std::string &ref_so, UnifiedMem &mem,
+                    uint32_t reset_pc) {
+  handle_ = dlopen(ref_so.c_str(), RTLD_LAZY);
+  if (!handle_) {
+    Logger::log_warn(fmt::format("[difftest] dlopen {} failed: {}", ref_so,
+                                 dlerror()));
+    return false;
+  }
+  auto ref_init =
+      reinterpret_cast<void (*)(int)>(dlsym(handle_, "difftest_init"));
+  memcpy_ = reinterpret_cast<decltype(memcpy_)>(
+      dlsym(handle_, "difftest_memcpy"));
+  regcpy_ = reinterpret_cast<decltype(regcpy_)>(
+      dlsym(handle_, "difftest_regcpy"));
+  auto exec =
+      reinterpret_cast<decltype(exec_)>(dlsym(handle_, "difftest_exec"));
+  if (!ref_init || !memcpy_ || !regcpy_ || !exec) {
+    Logger::log_warn(
+        fmt::format("[difftest] {} is missing difftest_* symbols", ref_so));
+    return false;
+  }
+
+  ref_init(0);
+  memcpy_(reset_pc, const_cast<uint8_t *>(mem.host_ptr(reset_pc)),
+          mem.image_size(), kToRef);
+  regcpy_(&ref_, kToDut);
+  for (auto &r : ref_.gpr) r = 0;
+  ref_.pc = reset_pc;
+  regcpy_(&ref_, kToRef);
+
+  exec_ = exec;
+  Logger::log_info(fmt::format("[difftest] ON, ref={}", ref_so));
+  return true;
+}
+
+void Difftest::close() {
+  if (handle_) dlclose(handle_);
+  handle_ = nullptr;
+  memcpy_ = nullptr;
+  regcpy_ = nullptr;
+  exec_ = nullptr;
+  ref_ = {};
+  pending_ = 0;
+  written_mask_ = 0;
+  group_first_pc_ = 0;
+}
+
+void Difftest::clear_ref_mem(const UnifiedMem &mem) {
+  if (!enabled()) return;
+  static uint8_t zero[UnifiedMem::kPageSize] = {};
+  mem.for_each_dirty_page([&](uint32_t addr) {
+    memcpy_(addr, zero, UnifiedMem::kPageSize, kToRef);
+  });
+}
+
+bool Difftest::commit(uint64_t cycle, uint32_t pc, uint32_t inst, bool we,
+                      uint32_t rd, uint32_t data, const RegFile &rf) {
+  if (pending_ == 0) {
+    if (pc != ref_.pc) return report_pc_mismatch(cycle, pc);
+    group_first_pc_ = pc;
+  }
+  if (!is_mmio_access(inst, rf)) {
+    pending_++;
+    if (we && rd != 0 && rd < kNumGprs) written_mask_ |= 1u << rd;
+    return true;
+  }
+  if (!flush(cycle, rf)) return false;
+  if (pc != ref_.pc) return report_pc_mismatch(cycle, pc);
+  skip_ref(pc + 4u, rf, we, rd, data);
+  return true;
+}
+
+bool Difftest::check_group(uint64_t cycle, const RegFile &rf) {
+  return flush(cycle, rf);
+}
+
+bool Difftest::flush(uint64_t cycle, const RegFile &rf) {
+  if (pending_ == 0) return true;
+  exec_(pending_);
+  regcpy_(&ref_, kToDut);
+
+  uint64_t n = pending_;
+  uint32_t mask = written_mask_;
+  pending_ = 0;
+  written_mask_ = 0;
+
+  bool ok = true;
+  while (mask) {
+    int r = __builtin_ctz(mask);
+    mask &= mask - 1;
+    if (ref_.gpr[r] == rf[r]) continue;
+    ok = false;
+    Logger::log_warn(fmt::format(
+        "[difftest] cycle={} x{} mismatch dut=0x{:x} ref=0x{:x}", cycle, r,
+        rf[r], ref_.gpr[r]));
+  }
+  if (!ok) {
+    Logger::log_warn(fmt::format(
+        "[difftest] retire group first_pc=0x{:x} n={} ref_next_pc=0x{:x}",
+        group_first_pc_, n, ref_.pc));
+  }
+  return ok;
+}
+
+bool Difftest::report_pc_mismatch(uint64_t cycle, uint32_t dut_pc) {
+  Logger::log_warn(
+      fmt::format("[difftest] cycle={} pc mismatch dut=0x{:x} ref=0x{:x}",
+                  cycle, dut_pc, ref_.pc));
+  return false;
+}
+
+void Difftest::skip_ref(uint32_t next_pc, const RegFile &rf, bool we,
+                        uint32_t rd, uint32_t data) {
+  for (int i = 0; i < kNumGprs; i++) ref_.gpr[i] = rf[i];
+  if (we && rd != 0 && rd < kNumGprs) ref_.gpr[rd] = data;
+  ref_.pc = next_pc;
+  regcpy_(&ref_, kToRef);
+}
+
+void Difftest::save(VerilatedSerialize &os) const {
+  bool has_ref = enabled();
+  ckpt_put(os, has_ref);
+  if (has_ref) ckpt_put(os, ref_);
+}
+
+bool Difftest::restore(VerilatedDeserialize &is, const UnifiedMem &mem) {
+  bool has_ref = false;
+  ckpt_get(is, has_ref);
+  RefRegs regs{};
+  if (has_ref) ckpt_get(is, regs);
+  if (!enabled()) return true;
+  if (!has_ref) {
+    Logger::log_warn(
+        "[difftest] checkpoint was saved without -d, REF state unknown");
+    return false;
+  }
+  ref_ = regs;
+  pending_ = 0;
+  written_mask_ = 0;
+  mem.for_each_dirty_page([&](uint32_t addr) {
+    memcpy_(addr, const_cast<uint8_t *>(mem.host_ptr(addr)),
+            UnifiedMem::kPageSize, kToRef);
+  });
+  regcpy_(&ref_, kToRef);
+  return true;
+}
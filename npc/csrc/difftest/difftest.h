@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct UnifiedMem;
+class VerilatedSerialize;
+class VerilatedDeserialize;
+
+// General-purpose registers of the guest ISA (ISA= in the Makefile). The
+// commit port addresses 32, but an RV32E program and REF only have 16.
+#ifdef NPC_RVE
+constexpr int kNumGprs = 16;
+#else
+constexpr int kNumGprs = 32;
+#endif
+
+// Lock-step co-simulation against a NEMU reference built as a shared object
+// (nemu/src/cpu/difftest/ref.c).
+//
+// Retired instructions are fed in program order through commit(). They are
+// not stepped on the REF one by one: a retire group is executed with a single
+// ref_difftest_exec(n) in check_group(), and only the registers written by the
+// group are compared. Loads/stores outside pmem cannot be reproduced by the
+// REF, so they split the group and the REF register file is overwritten with
+// the DUT state instead (the same idea as NEMU's difftest_skip_ref()).
+class Difftest {
+ public:
+  using RegFile = std::array<uint32_t, 32>;
+
+  Difftest() = default;
+  ~Difftest() { close(); }
+  Difftest(const Difftest &) = delete;
+  Difftest &operator=(const Difftest &) = delete;
+
+  bool init(const std::string &ref_so, UnifiedMem &mem, uint32_t reset_pc);
+  bool enabled() const { return exec_ != nullptr; }
+  // dlclose()s the REF and drops all state, so init() can run again.
+  void close();
+  // Zeroes every dirty pmem page on the REF side. The REF keeps its pmem
+  // across close()/init() if the object is not unloaded, so the batch loop
+  // calls this before UnifiedMem::clear() forgets which pages were used.
+  void clear_ref_mem(const UnifiedMem &mem);
+
+  // `rf` is the architectural state *before* this instruction writes rd.
+  bool commit(uint64_t cycle, uint32_t pc, uint32_t inst, bool we, uint32_t rd,
+              uint32_t data, const RegFile &rf);
+  // `rf` is the architectural state after the whole retire group.
+  bool check_group(uint64_t cycle, const RegFile &rf);
+
+  // Checkpointing happens between retire groups, so only the REF register
+  // state is saved. restore() also copies the dirty pmem pages, which
+  // include those written since the checkpoint, into the REF.
+  void save(VerilatedSerialize &os) const;
+  bool restore(VerilatedDeserialize &is, const UnifiedMem &mem);
+
+ private:
+  // Layout of riscv32_CPU_state in nemu/src/isa/riscv32/include/isa-def.h,
+  // whose gpr[] has 16 entries under CONFIG_RVE. The tail is padding so a
+  // REF built with a larger CPU_state cannot overrun it.
+  struct RefRegs {
+    uint32_t gpr[kNumGprs];
+    uint32_t pc;
+    uint32_t csr[4];
+    uint32_t reserved[27];
+  };
+
+  bool flush(uint64_t cycle, const RegFile &rf);
+  bool report_pc_mismatch(uint64_t cycle, uint32_t dut_pc);
+  void skip_ref(uint32_t next_pc, const RegFile &rf, bool we, uint32_t rd,
+                uint32_t data);
+
+  void *handle_ = nullptr;
+  void (*memcpy_)(uint32_t addr, void *buf, size_t n, bool direction) = nullptr;
+  void (*regcpy_)(void *dut, bool direction) = nullptr;
+  void (*exec_)(uint64_t n) = nullptr;
+
+  RefRegs ref_{};
+  uint64_t pending_ = 0;
+  uint32_t written_mask_ = 0;
+  uint32_t group_first_pc_ = 0;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <string>
+
+// Quoted JSON string literal for `s`, shared by the --result / --batch
+// summaries of npc and the reports of tools/regress.cpp.
+inline std::string json_string(const std::string &s) {
+  std::string out = "\"";
+  for (char c : s) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\b': out += "\\b"; break;
+      case '\f': out += "\\f"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += fmt::format("\\u{:04x}", static_cast<unsigned char>(c));
+        } else {
+          out += c;
+        }
+    }
+  }
+  return out + "\"";
+}
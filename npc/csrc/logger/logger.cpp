@@ -79,7 +79,8 @@ void Logger::log_progress(const Snapshot& snap) {
   spdlog::info("{}", format_progress(snap));
 }
 
-void Logger::log_perf(const Snapshot& snap, double ipc, double cpi) {
+void Logger::log_perf(const Snapshot& snap, double ipc, double cpi,
+                      const Occupancy& occ) {
   uint64_t cycles = snap.perf_cycles ? snap.perf_cycles : snap.cycles;
   uint64_t commit_instrs =
       snap.perf_commit_instrs ? snap.perf_commit_instrs : snap.total_commits;
@@ -94,6 +95,30 @@ void Logger::log_perf(const Snapshot& snap, double ipc, double cpi) {
       "IPC={} CPI={} cycles={} commit_instrs={} commit_cycles={} "
       "no_commit_cycles={}",
       ipc, cpi, cycles, commit_instrs, commit_cycles, nocommit_cycles);
+  uint64_t td_frontend =
+      snap.perf_td_fe_icache_slots + snap.perf_td_fe_other_slots;
+  uint64_t td_backend = snap.perf_td_be_mem_slots + snap.perf_td_be_alu_slots +
+                        snap.perf_td_be_bru_slots + snap.perf_td_be_mdu_slots +
+                        snap.perf_td_be_csr_slots + snap.perf_td_be_other_slots;
+  uint64_t td_slots = snap.perf_td_retire_slots + snap.perf_td_badspec_slots +
+                      td_frontend + td_backend;
+  auto slot_pct = [&](uint64_t v) -> double {
+    if (td_slots == 0) return 0.0;
+    return 100.0 * static_cast<double>(v) / static_cast<double>(td_slots);
+  };
+  spdlog::info(
+      "top-down slots={} retiring={:.1f}% bad_spec={:.1f}% "
+      "frontend={:.1f}% (icache={:.1f}% other={:.1f}%) backend={:.1f}% "
+      "(mem={:.1f}% alu={:.1f}% bru={:.1f}% mdu={:.1f}% csr={:.1f}% "
+      "other={:.1f}%)",
+      td_slots, slot_pct(snap.perf_td_retire_slots),
+      slot_pct(snap.perf_td_badspec_slots), slot_pct(td_frontend),
+      slot_pct(snap.perf_td_fe_icache_slots),
+      slot_pct(snap.perf_td_fe_other_slots), slot_pct(td_backend),
+      slot_pct(snap.perf_td_be_mem_slots), slot_pct(snap.perf_td_be_alu_slots),
+      slot_pct(snap.perf_td_be_bru_slots), slot_pct(snap.perf_td_be_mdu_slots),
+      slot_pct(snap.perf_td_be_csr_slots),
+      slot_pct(snap.perf_td_be_other_slots));
   spdlog::info(
       "stall cycles (not exclusive) fe_empty={}({:.1f}%) fe_stall={}({:.1f}%) "
       "dec_stall={}({:.1f}%) rob_full={}({:.1f}%) "
@@ -165,6 +190,59 @@ void Logger::log_perf(const Snapshot& snap, double ipc, double cpi) {
       snap.perf_dcache_wait_refill_cycles,
       pct(snap.perf_dcache_wait_refill_cycles),
       snap.perf_dcache_resp_cycles, pct(snap.perf_dcache_resp_cycles));
+  double mem_bw = cycles ? static_cast<double>(snap.mem_read_bytes +
+                                               snap.mem_write_bytes) /
+                               static_cast<double>(cycles)
+                         : 0.0;
+  double mem_lat = snap.mem_read_reqs
+                       ? static_cast<double>(snap.mem_read_latency_sum) /
+                             static_cast<double>(snap.mem_read_reqs)
+                       : 0.0;
+  spdlog::info(
+      "mem model={} reads={} writes={} bytes(rd/wr)={}/{} "
+      "bw={:.3f}B/cycle(peak={}) bus_busy={}({:.1f}%) "
+      "avg_read_lat={:.1f} row(hit/miss)={}/{}",
+      snap.mem_model, snap.mem_read_reqs, snap.mem_write_reqs,
+      snap.mem_read_bytes, snap.mem_write_bytes, mem_bw,
+      snap.mem_bytes_per_cycle, snap.mem_bus_busy_cycles,
+      pct(snap.mem_bus_busy_cycles), mem_lat, snap.mem_row_hits,
+      snap.mem_row_misses);
+  if (snap.l2_size_bytes) {
+    auto rate = [](uint64_t hits, uint64_t misses) {
+      return hits + misses ? 100.0 * static_cast<double>(hits) /
+                                 static_cast<double>(hits + misses)
+                           : 0.0;
+    };
+    spdlog::info(
+        "l2 size={}KiB i(hit/miss)={}/{}({:.1f}%) d(hit/miss)={}/{}({:.1f}%) "
+        "wb(hit/miss)={}/{} evictions={} dirty={}",
+        snap.l2_size_bytes / 1024, snap.l2_ihits, snap.l2_imisses,
+        rate(snap.l2_ihits, snap.l2_imisses), snap.l2_dhits, snap.l2_dmisses,
+        rate(snap.l2_dhits, snap.l2_dmisses), snap.l2_wb_hits,
+        snap.l2_wb_misses, snap.l2_evictions, snap.l2_dirty_evictions);
+  }
+  if (snap.axi_reads + snap.axi_writes > 0) {
+    double axi_lat = snap.axi_reads
+                         ? static_cast<double>(snap.axi_read_latency_sum) /
+                               static_cast<double>(snap.axi_reads)
+                         : 0.0;
+    spdlog::info(
+        "axi reads={} writes={} r_beats={} r_bus={:.1f}% "
+        "avg_read_lat={:.1f} r_conflicts={}({:.1f}%)",
+        snap.axi_reads, snap.axi_writes, snap.axi_r_beats,
+        pct(snap.axi_r_beats), axi_lat, snap.axi_r_conflict_cycles,
+        pct(snap.axi_r_conflict_cycles));
+  }
+  if (occ.samples() == 0) return;
+  fmt::memory_buffer occ_buf;
+  for (int i = 0; i < Occupancy::kNumStructures; i++) {
+    auto s = static_cast<Occupancy::Structure>(i);
+    fmt::format_to(std::back_inserter(occ_buf),
+                   " {}(mean/p50/p90/p99/max)={:.1f}/{}/{}/{}/{}",
+                   Occupancy::name(s), occ.mean(s), occ.percentile(s, 50),
+                   occ.percentile(s, 90), occ.percentile(s, 99), occ.max(s));
+  }
+  spdlog::info("occupancy cycles={}{}", occ.samples(), fmt::to_string(occ_buf));
 }
 
 void Logger::log_info(const std::string& msg) { spdlog::info("{}", msg); }
@@ -200,21 +278,24 @@ void Logger::log_fe_mismatch(const Snapshot& snap) {
       snap.cycles, snap.dbg_fe_pc, snap.fe_mismatch_mask, fe_str, mem_str);
 }
 
-void Logger::maybe_log_flush(const Snapshot& snap) {
-  if (!snap.backend_flush) return;
+void Logger::maybe_log_flush(SnapshotView& view) {
   if (!(g_config.commit_trace || g_config.bru_trace)) return;
+  const Snapshot& snap = view.get(kSnapBru);
+  if (!snap.backend_flush) return;
   log_flush(snap.cycles, snap.backend_redirect_pc);
 }
 
-void Logger::maybe_log_bru(const Snapshot& snap) {
+void Logger::maybe_log_bru(SnapshotView& view) {
   if (!g_config.bru_trace) return;
+  const Snapshot& snap = view.get(kSnapBru);
   if (!snap.backend_flush || !snap.dbg_bru_mispred) return;
   log_bru(snap);
 }
 
 void Logger::maybe_log_fe_mismatch(
-    const Snapshot& snap, const std::function<uint32_t(uint32_t)>& read_word) {
+    SnapshotView& view, const std::function<uint32_t(uint32_t)>& read_word) {
   if (!g_config.fe_trace) return;
+  const Snapshot& snap = view.get(kSnapFrontend);
   if (!snap.dbg_fe_valid || !snap.dbg_fe_ready) return;
   std::array<uint32_t, 4> mem_instrs{};
   uint32_t mismatch_mask = 0;
@@ -232,22 +313,24 @@ void Logger::maybe_log_fe_mismatch(
   log_fe_mismatch(fe_snap);
 }
 
-void Logger::maybe_log_stall(const Snapshot& snap) {
+void Logger::maybe_log_stall(SnapshotView& view) {
   if (!g_config.stall_trace) return;
   if (g_config.stall_threshold == 0) return;
-  if (snap.no_commit_cycles < g_config.stall_threshold) return;
-  if (snap.no_commit_cycles != g_config.stall_threshold &&
-      (snap.no_commit_cycles % g_config.stall_threshold) != 0) {
+  uint64_t no_commit = view.base().no_commit_cycles;
+  if (no_commit < g_config.stall_threshold) return;
+  if (no_commit != g_config.stall_threshold &&
+      (no_commit % g_config.stall_threshold) != 0) {
     return;
   }
-  log_stall(snap);
+  log_stall(view.get(kSnapAll));
 }
 
-void Logger::maybe_log_progress(const Snapshot& snap) {
+void Logger::maybe_log_progress(SnapshotView& view) {
   if (g_config.progress_interval == 0) return;
-  if (snap.cycles == 0) return;
-  if ((snap.cycles % g_config.progress_interval) != 0) return;
-  log_progress(snap);
+  uint64_t cycles = view.base().cycles;
+  if (cycles == 0) return;
+  if ((cycles % g_config.progress_interval) != 0) return;
+  log_progress(view.get(kSnapBru | kSnapRob | kSnapLsu));
 }
 
 std::string Logger::format_stall(const Snapshot& snap) {
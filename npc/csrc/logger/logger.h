@@ -5,6 +5,7 @@
 #include <functional>
 #include <string>
 
+#include "logger/occupancy.h"
 #include "logger/snapshot.h"
 
 struct LogConfig {
@@ -31,19 +32,22 @@ class Logger {
                          uint32_t a0);
   static void log_stall(const Snapshot &snap);
   static void log_progress(const Snapshot &snap);
-  static void log_perf(const Snapshot &snap, double ipc, double cpi);
+  static void log_perf(const Snapshot &snap, double ipc, double cpi,
+                       const Occupancy &occ);
   static void log_info(const std::string &msg);
   static void log_warn(const std::string &msg);
   static void log_flush(uint64_t cycle, uint32_t redirect_pc);
   static void log_bru(const Snapshot &snap);
   static void log_fe_mismatch(const Snapshot &snap);
-  static void maybe_log_flush(const Snapshot &snap);
-  static void maybe_log_bru(const Snapshot &snap);
+  // The maybe_log_* checks read only the parts of `view` they print, after
+  // their cheap conditions pass.
+  static void maybe_log_flush(SnapshotView &view);
+  static void maybe_log_bru(SnapshotView &view);
   static void maybe_log_fe_mismatch(
-      const Snapshot &snap,
+      SnapshotView &view,
       const std::function<uint32_t(uint32_t)> &read_word);
-  static void maybe_log_stall(const Snapshot &snap);
-  static void maybe_log_progress(const Snapshot &snap);
+  static void maybe_log_stall(SnapshotView &view);
+  static void maybe_log_progress(SnapshotView &view);
   static bool needs_periodic_snapshot();
 
   static const LogConfig &config();
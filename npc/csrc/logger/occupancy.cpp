@@ -0,0 +1,79 @@
+#include "logger/occupancy.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "Vtb_triathlon.h"
+
+namespace {
+const char *const kNames[Occupancy::kNumStructures] = {
+    "rob", "sb", "ibuf", "alu_rs", "bru_rs", "lsu_rs"};
+
+// RS busy vectors wider than 64 bits are VlWide word arrays.
+template <typename T>
+uint32_t busy(const T &mask) {
+  if constexpr (std::is_integral_v<T>) {
+    return static_cast<uint32_t>(__builtin_popcountll(mask));
+  } else {
+    uint32_t n = 0;
+    for (size_t i = 0; i < sizeof(mask) / sizeof(mask[0]); i++) {
+      n += static_cast<uint32_t>(__builtin_popcount(mask[i]));
+    }
+    return n;
+  }
+}
+}  // namespace
+
+void Occupancy::sample(const Vtb_triathlon *top) {
+  if (samples_++ == 0) {
+    hist_[kRob].assign(top->dbg_rob_depth_o + 1, 0);
+    hist_[kSb].assign(top->dbg_sb_depth_o + 1, 0);
+    hist_[kIbuf].assign(top->dbg_ibuf_depth_o + 1, 0);
+    for (Structure s : {kAluRs, kBruRs, kLsuRs}) {
+      hist_[s].assign(top->dbg_rs_depth_o + 1, 0);
+    }
+  }
+  add(kRob, top->dbg_rob_count_o);
+  add(kSb, top->dbg_sb_count_o);
+  add(kIbuf, top->dbg_ibuf_count_o);
+  add(kAluRs, busy(top->dbg_alu_rs_busy_o));
+  add(kBruRs, busy(top->dbg_bru_rs_busy_o));
+  add(kLsuRs, busy(top->dbg_lsu_rs_busy_o));
+}
+
+// Clamped, so an occupancy above the configured depth lands in the last
+// bucket instead of wrapping into a low one.
+void Occupancy::add(Structure s, uint32_t n) {
+  std::vector<uint64_t> &h = hist_[s];
+  h[std::min<size_t>(n, h.size() - 1)]++;
+}
+
+const char *Occupancy::name(Structure s) { return kNames[s]; }
+
+double Occupancy::mean(Structure s) const {
+  if (samples_ == 0) return 0.0;
+  double sum = 0;
+  for (size_t n = 0; n < hist_[s].size(); n++) {
+    sum += static_cast<double>(n) * static_cast<double>(hist_[s][n]);
+  }
+  return sum / static_cast<double>(samples_);
+}
+
+uint32_t Occupancy::percentile(Structure s, double p) const {
+  double target = static_cast<double>(samples_) * p / 100.0;
+  uint64_t seen = 0;
+  for (size_t n = 0; n < hist_[s].size(); n++) {
+    seen += hist_[s][n];
+    if (seen > 0 && static_cast<double>(seen) >= target) {
+      return static_cast<uint32_t>(n);
+    }
+  }
+  return 0;
+}
+
+uint32_t Occupancy::max(Structure s) const {
+  for (size_t n = hist_[s].size(); n-- > 1;) {
+    if (hist_[s][n]) return static_cast<uint32_t>(n);
+  }
+  return 0;
+}
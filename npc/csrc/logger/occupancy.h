@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct Vtb_triathlon;
+
+// Per-cycle occupancy histograms of the buffering structures, reported as
+// percentiles by Logger::log_perf to show whether ROB_DEPTH, SB_DEPTH,
+// RS_DEPTH and IB_DEPTH are over- or under-provisioned. Sampling is one
+// counter increment per structure per cycle. Each histogram has DEPTH + 1
+// buckets, sized from the model's dbg_*_depth_o ports on the first sample.
+class Occupancy {
+ public:
+  enum Structure { kRob, kSb, kIbuf, kAluRs, kBruRs, kLsuRs, kNumStructures };
+  void sample(const Vtb_triathlon *top);
+
+  static const char *name(Structure s);
+  uint64_t samples() const { return samples_; }
+  double mean(Structure s) const;
+  // Smallest occupancy that at least `p` percent of cycles do not exceed.
+  uint32_t percentile(Structure s, double p) const;
+  uint32_t max(Structure s) const;
+
+ private:
+  void add(Structure s, uint32_t n);
+
+  uint64_t samples_ = 0;
+  std::vector<uint64_t> hist_[kNumStructures];
+};
@@ -0,0 +1,64 @@
+#include "logger/perf_series.h"
+
+#include <fmt/format.h>
+
+#include <cstring>
+#include <iostream>
+
+namespace {
+bool is_perf(const char *name) { return std::strncmp(name, "perf_", 5) == 0; }
+}  // namespace
+
+bool PerfSeries::open(const std::string &path, uint64_t interval) {
+  fp_ = std::fopen(path.c_str(), "w");
+  if (!fp_) {
+    std::cerr << "Failed to open perf series: " << path << "\n";
+    return false;
+  }
+  interval_ = interval;
+  std::string header = "cycle_begin,cycle_end,instrs,ipc";
+  for_each_counter(snap_, [&](const char *name, uint64_t) {
+    if (is_perf(name)) header += fmt::format(",{}", name + 5);
+  });
+  fmt::print(fp_, "{}\n", header);
+  return true;
+}
+
+void PerfSeries::close() {
+  if (!fp_) return;
+  std::fclose(fp_);
+  fp_ = nullptr;
+}
+
+void PerfSeries::read(const Vtb_triathlon *top, std::vector<uint64_t> &out) {
+  collect_perf(top, snap_);
+  out.clear();
+  for_each_counter(snap_, [&](const char *name, uint64_t value) {
+    if (is_perf(name)) out.push_back(value);
+  });
+}
+
+void PerfSeries::start(const Vtb_triathlon *top, uint64_t cycle) {
+  last_cycle_ = cycle;
+  read(top, prev_);
+  prev_instrs_ = snap_.perf_commit_instrs;
+  prev_cycles_ = snap_.perf_cycles;
+}
+
+void PerfSeries::sample(const Vtb_triathlon *top, uint64_t cycle) {
+  if (!fp_ || prev_.empty() || cycle <= last_cycle_) return;
+  read(top, cur_);
+  uint64_t instrs = snap_.perf_commit_instrs - prev_instrs_;
+  uint64_t cycles = snap_.perf_cycles - prev_cycles_;
+  double ipc = cycles ? static_cast<double>(instrs) / cycles : 0.0;
+  std::string row =
+      fmt::format("{},{},{},{:.4f}", last_cycle_, cycle, instrs, ipc);
+  for (size_t i = 0; i < cur_.size(); i++) {
+    row += fmt::format(",{}", cur_[i] - prev_[i]);
+  }
+  fmt::print(fp_, "{}\n", row);
+  prev_.swap(cur_);
+  prev_instrs_ = snap_.perf_commit_instrs;
+  prev_cycles_ = snap_.perf_cycles;
+  last_cycle_ = cycle;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "logger/snapshot.h"
+
+struct Vtb_triathlon;
+
+// Time series of the RTL perf_* counters for --perf-interval/--perf-out.
+// Each CSV row holds the counter deltas over one interval of simulated
+// cycles, so program phases stay visible instead of averaging out.
+class PerfSeries {
+ public:
+  ~PerfSeries() { close(); }
+
+  bool open(const std::string &path, uint64_t interval);
+  void close();
+  bool is_open() const { return fp_ != nullptr; }
+  uint64_t interval() const { return interval_; }
+
+  // Baseline after reset or restore; `cycle` is the next cycle to simulate.
+  void start(const Vtb_triathlon *top, uint64_t cycle);
+  // Closes the interval ending before `cycle`. Cycles at or before the last
+  // sample are ignored.
+  void sample(const Vtb_triathlon *top, uint64_t cycle);
+
+ private:
+  void read(const Vtb_triathlon *top, std::vector<uint64_t> &out);
+
+  FILE *fp_ = nullptr;
+  uint64_t interval_ = 0;
+  uint64_t last_cycle_ = 0;
+  Snapshot snap_{};
+  std::vector<uint64_t> prev_;
+  uint64_t prev_instrs_ = 0;
+  uint64_t prev_cycles_ = 0;
+  std::vector<uint64_t> cur_;
+};
@@ -0,0 +1,64 @@
+#include "logger/sim_stats.h"
+
+#include <fmt/format.h>
+
+#include "logger/logger.h"
+
+namespace {
+const char *const kPhaseNames[SimStats::kNumPhases] = {"eval", "mem",
+                                                       "snapshot", "log"};
+
+double rate_khz(uint64_t cycles, uint64_t ns) {
+  return ns ? static_cast<double>(cycles) * 1e6 / static_cast<double>(ns)
+            : 0.0;
+}
+}  // namespace
+
+void SimStats::start(uint64_t cycle) {
+  start_ = last_ = Clock::now();
+  start_cycle_ = last_cycle_ = cycle;
+}
+
+double SimStats::khz(uint64_t cycle) const {
+  return rate_khz(cycle - start_cycle_, elapsed_ns(start_));
+}
+
+void SimStats::log_progress(uint64_t cycle) {
+  if (!enabled_ || cycle <= last_cycle_) return;
+  uint64_t interval_ns = elapsed_ns(last_);
+  Logger::log_info(fmt::format(
+      "[host  ] cycle={} khz={:.1f} interval_khz={:.1f} {}", cycle,
+      khz(cycle), rate_khz(cycle - last_cycle_, interval_ns),
+      format_phases(elapsed_ns(start_))));
+  last_ = Clock::now();
+  last_cycle_ = cycle;
+}
+
+void SimStats::report(uint64_t cycle) const {
+  if (!enabled_) return;
+  uint64_t total_ns = elapsed_ns(start_);
+  Logger::log_info(fmt::format(
+      "sim-stats: cycles={} wall={:.3f}s khz={:.1f} {}", cycle - start_cycle_,
+      total_ns * 1e-9, rate_khz(cycle - start_cycle_, total_ns),
+      format_phases(total_ns)));
+}
+
+// Share of wall time per phase; `other` is the rest of the harness loop
+// (difftest, wave dumps, profilers, trace writers).
+std::string SimStats::format_phases(uint64_t total_ns) const {
+  std::string out;
+  uint64_t timed = 0;
+  auto pct = [&](uint64_t ns) {
+    return total_ns ? 100.0 * static_cast<double>(ns) /
+                          static_cast<double>(total_ns)
+                    : 0.0;
+  };
+  for (int p = 0; p < kNumPhases; p++) {
+    out += fmt::format("{}{}={:.1f}%", p ? " " : "", kPhaseNames[p],
+                       pct(ns_[p]));
+    timed += ns_[p];
+  }
+  out += fmt::format(" other={:.1f}%", pct(total_ns > timed ? total_ns - timed
+                                                            : 0));
+  return out;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Host-side speed of the simulator for --sim-stats: wall time spent in the
+// Verilator model, the memory system, snapshots and logging, and the
+// simulated cycle rate. Phases are only timed when enabled.
+class SimStats {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  enum Phase { kEval, kMem, kSnapshot, kLog, kNumPhases };
+
+  // Charges the wall time of its lifetime to one phase. Scopes nest; time
+  // goes to the innermost one.
+  class Scope {
+   public:
+    Scope(SimStats &stats, Phase phase) : stats_(stats) {
+      if (stats_.enabled_) prev_ = stats_.enter(phase);
+    }
+    ~Scope() {
+      if (stats_.enabled_) stats_.enter(prev_);
+    }
+
+   private:
+    SimStats &stats_;
+    Phase prev_ = kNumPhases;
+  };
+
+  void enable() { enabled_ = true; }
+  bool enabled() const { return enabled_; }
+
+  // Wall-clock origin; `cycle` is the next cycle to simulate.
+  void start(uint64_t cycle);
+  // One line per --progress interval: overall and interval cycle rate.
+  void log_progress(uint64_t cycle);
+  void report(uint64_t cycle) const;
+
+  double seconds() const { return elapsed_ns(start_) * 1e-9; }
+  double khz(uint64_t cycle) const;
+
+ private:
+  static uint64_t elapsed_ns(Clock::time_point since) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                             since)
+            .count());
+  }
+  // Switches the active phase (kNumPhases: none); returns the previous one.
+  Phase enter(Phase phase) {
+    Clock::time_point now = Clock::now();
+    if (active_ != kNumPhases) {
+      ns_[active_] += static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(now - mark_)
+              .count());
+    }
+    Phase prev = active_;
+    active_ = phase;
+    mark_ = now;
+    return prev;
+  }
+  std::string format_phases(uint64_t total_ns) const;
+
+  bool enabled_ = false;
+  Clock::time_point start_;
+  uint64_t start_cycle_ = 0;
+  uint64_t ns_[kNumPhases] = {};
+  Phase active_ = kNumPhases;
+  Clock::time_point mark_;
+  Clock::time_point last_;
+  uint64_t last_cycle_ = 0;
+};
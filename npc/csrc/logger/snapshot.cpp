@@ -1,106 +1,11 @@
 #include "logger/snapshot.h"
 
-#include "Vtb_triathlon.h"
-
-Snapshot collect_snapshot(const Vtb_triathlon *top,
-                          uint64_t cycles,
-                          uint64_t total_commits,
-                          uint64_t no_commit_cycles,
-                          uint32_t last_commit_pc,
-                          uint32_t last_commit_inst,
-                          uint32_t a0) {
-  Snapshot snap{};
-  snap.cycles = cycles;
-  snap.total_commits = total_commits;
-  snap.no_commit_cycles = no_commit_cycles;
-  snap.last_commit_pc = last_commit_pc;
-  snap.last_commit_inst = last_commit_inst;
-  snap.a0 = a0;
-
-  snap.dbg_fe_valid = static_cast<uint8_t>(top->dbg_fe_valid_o);
-  snap.dbg_fe_ready = static_cast<uint8_t>(top->dbg_fe_ready_o);
-  snap.dbg_fe_pc = static_cast<uint32_t>(top->dbg_fe_pc_o);
-  for (int i = 0; i < 4; i++) {
-    snap.dbg_fe_instrs[i] = static_cast<uint32_t>(top->dbg_fe_instrs_o[i]);
-  }
-
-  snap.dbg_dec_valid = static_cast<uint8_t>(top->dbg_dec_valid_o);
-  snap.dbg_dec_ready = static_cast<uint8_t>(top->dbg_dec_ready_o);
-  snap.dbg_rob_ready = static_cast<uint8_t>(top->dbg_rob_ready_o);
-
-  snap.dbg_lsu_ld_req_valid = static_cast<uint8_t>(top->dbg_lsu_ld_req_valid_o);
-  snap.dbg_lsu_ld_req_ready = static_cast<uint8_t>(top->dbg_lsu_ld_req_ready_o);
-  snap.dbg_lsu_ld_req_addr = static_cast<uint32_t>(top->dbg_lsu_ld_req_addr_o);
-  snap.dbg_lsu_ld_rsp_valid = static_cast<uint8_t>(top->dbg_lsu_ld_rsp_valid_o);
-  snap.dbg_lsu_ld_rsp_ready = static_cast<uint8_t>(top->dbg_lsu_ld_rsp_ready_o);
-
-  snap.dbg_lsu_issue_valid = static_cast<uint8_t>(top->dbg_lsu_issue_valid_o);
-  snap.dbg_lsu_req_ready = static_cast<uint8_t>(top->dbg_lsu_req_ready_o);
-  snap.dbg_lsu_issue_ready = static_cast<uint8_t>(top->dbg_lsu_issue_ready_o);
-  snap.dbg_lsu_free_count = static_cast<uint32_t>(top->dbg_lsu_free_count_o);
-
-  snap.dbg_lsu_rs_busy = static_cast<uint32_t>(top->dbg_lsu_rs_busy_o);
-  snap.dbg_lsu_rs_ready = static_cast<uint32_t>(top->dbg_lsu_rs_ready_o);
-  snap.dbg_lsu_rs_head_valid = static_cast<uint8_t>(top->dbg_lsu_rs_head_valid_o);
-  snap.dbg_lsu_rs_head_idx = static_cast<uint32_t>(top->dbg_lsu_rs_head_idx_o);
-  snap.dbg_lsu_rs_head_dst = static_cast<uint32_t>(top->dbg_lsu_rs_head_dst_o);
-  snap.dbg_lsu_rs_head_r1_ready = static_cast<uint8_t>(top->dbg_lsu_rs_head_r1_ready_o);
-  snap.dbg_lsu_rs_head_r2_ready = static_cast<uint8_t>(top->dbg_lsu_rs_head_r2_ready_o);
-  snap.dbg_lsu_rs_head_has_rs1 = static_cast<uint8_t>(top->dbg_lsu_rs_head_has_rs1_o);
-  snap.dbg_lsu_rs_head_has_rs2 = static_cast<uint8_t>(top->dbg_lsu_rs_head_has_rs2_o);
-  snap.dbg_lsu_rs_head_q1 = static_cast<uint32_t>(top->dbg_lsu_rs_head_q1_o);
-  snap.dbg_lsu_rs_head_q2 = static_cast<uint32_t>(top->dbg_lsu_rs_head_q2_o);
-  snap.dbg_lsu_rs_head_sb_id = static_cast<uint32_t>(top->dbg_lsu_rs_head_sb_id_o);
-  snap.dbg_lsu_rs_head_is_load = static_cast<uint8_t>(top->dbg_lsu_rs_head_is_load_o);
-  snap.dbg_lsu_rs_head_is_store = static_cast<uint8_t>(top->dbg_lsu_rs_head_is_store_o);
-
-  snap.dbg_sb_alloc_req = static_cast<uint32_t>(top->dbg_sb_alloc_req_o);
-  snap.dbg_sb_alloc_ready = static_cast<uint8_t>(top->dbg_sb_alloc_ready_o);
-  snap.dbg_sb_alloc_fire = static_cast<uint8_t>(top->dbg_sb_alloc_fire_o);
-
-  snap.dbg_sb_dcache_req_valid = static_cast<uint8_t>(top->dbg_sb_dcache_req_valid_o);
-  snap.dbg_sb_dcache_req_ready = static_cast<uint8_t>(top->dbg_sb_dcache_req_ready_o);
-  snap.dbg_sb_dcache_req_addr = static_cast<uint32_t>(top->dbg_sb_dcache_req_addr_o);
-
-  snap.icache_miss_req_valid = static_cast<uint8_t>(top->icache_miss_req_valid_o);
-  snap.icache_miss_req_ready = static_cast<uint8_t>(top->icache_miss_req_ready_i);
-  snap.dcache_miss_req_valid = static_cast<uint8_t>(top->dcache_miss_req_valid_o);
-  snap.dcache_miss_req_ready = static_cast<uint8_t>(top->dcache_miss_req_ready_i);
-
-  snap.backend_flush = static_cast<uint8_t>(top->backend_flush_o);
-  snap.backend_redirect_pc = static_cast<uint32_t>(top->backend_redirect_pc_o);
-  snap.dbg_bru_valid = static_cast<uint8_t>(top->dbg_bru_valid_o);
-  snap.dbg_bru_mispred = static_cast<uint8_t>(top->dbg_bru_mispred_o);
-  snap.dbg_bru_pc = static_cast<uint32_t>(top->dbg_bru_pc_o);
-  snap.dbg_bru_imm = static_cast<uint32_t>(top->dbg_bru_imm_o);
-  snap.dbg_bru_op = static_cast<uint32_t>(top->dbg_bru_op_o);
-  snap.dbg_bru_is_jump = static_cast<uint8_t>(top->dbg_bru_is_jump_o);
-  snap.dbg_bru_is_branch = static_cast<uint8_t>(top->dbg_bru_is_branch_o);
-
-  snap.dbg_rob_head_fu = static_cast<uint32_t>(top->dbg_rob_head_fu_o);
-  snap.dbg_rob_head_complete = static_cast<uint8_t>(top->dbg_rob_head_complete_o);
-  snap.dbg_rob_head_is_store = static_cast<uint8_t>(top->dbg_rob_head_is_store_o);
-  snap.dbg_rob_head_pc = static_cast<uint32_t>(top->dbg_rob_head_pc_o);
-  snap.dbg_rob_count = static_cast<uint32_t>(top->dbg_rob_count_o);
-  snap.dbg_rob_head_ptr = static_cast<uint32_t>(top->dbg_rob_head_ptr_o);
-  snap.dbg_rob_tail_ptr = static_cast<uint32_t>(top->dbg_rob_tail_ptr_o);
+#include <cstring>
 
-  snap.dbg_rob_q2_valid = static_cast<uint8_t>(top->dbg_rob_q2_valid_o);
-  snap.dbg_rob_q2_idx = static_cast<uint32_t>(top->dbg_rob_q2_idx_o);
-  snap.dbg_rob_q2_fu = static_cast<uint32_t>(top->dbg_rob_q2_fu_o);
-  snap.dbg_rob_q2_complete = static_cast<uint8_t>(top->dbg_rob_q2_complete_o);
-  snap.dbg_rob_q2_is_store = static_cast<uint8_t>(top->dbg_rob_q2_is_store_o);
-  snap.dbg_rob_q2_pc = static_cast<uint32_t>(top->dbg_rob_q2_pc_o);
-
-  snap.dbg_sb_count = static_cast<uint32_t>(top->dbg_sb_count_o);
-  snap.dbg_sb_head_ptr = static_cast<uint32_t>(top->dbg_sb_head_ptr_o);
-  snap.dbg_sb_tail_ptr = static_cast<uint32_t>(top->dbg_sb_tail_ptr_o);
-  snap.dbg_sb_head_valid = static_cast<uint8_t>(top->dbg_sb_head_valid_o);
-  snap.dbg_sb_head_committed = static_cast<uint8_t>(top->dbg_sb_head_committed_o);
-  snap.dbg_sb_head_addr_valid = static_cast<uint8_t>(top->dbg_sb_head_addr_valid_o);
-  snap.dbg_sb_head_data_valid = static_cast<uint8_t>(top->dbg_sb_head_data_valid_o);
-  snap.dbg_sb_head_addr = static_cast<uint32_t>(top->dbg_sb_head_addr_o);
+#include "Vtb_triathlon.h"
+#include "logger/sim_stats.h"
 
+void collect_perf(const Vtb_triathlon *top, Snapshot &snap) {
   snap.perf_cycles = static_cast<uint64_t>(top->perf_cycles_o);
   snap.perf_commit_cycles = static_cast<uint64_t>(top->perf_commit_cycles_o);
   snap.perf_commit_instrs = static_cast<uint64_t>(top->perf_commit_instrs_o);
@@ -166,6 +71,344 @@ Snapshot collect_snapshot(const Vtb_triathlon *top,
       static_cast<uint64_t>(top->perf_dcache_wait_refill_cycles_o);
   snap.perf_dcache_resp_cycles =
       static_cast<uint64_t>(top->perf_dcache_resp_cycles_o);
+  snap.perf_td_retire_slots =
+      static_cast<uint64_t>(top->perf_td_retire_slots_o);
+  snap.perf_td_badspec_slots =
+      static_cast<uint64_t>(top->perf_td_badspec_slots_o);
+  snap.perf_td_fe_icache_slots =
+      static_cast<uint64_t>(top->perf_td_fe_icache_slots_o);
+  snap.perf_td_fe_other_slots =
+      static_cast<uint64_t>(top->perf_td_fe_other_slots_o);
+  snap.perf_td_be_mem_slots =
+      static_cast<uint64_t>(top->perf_td_be_mem_slots_o);
+  snap.perf_td_be_alu_slots =
+      static_cast<uint64_t>(top->perf_td_be_alu_slots_o);
+  snap.perf_td_be_bru_slots =
+      static_cast<uint64_t>(top->perf_td_be_bru_slots_o);
+  snap.perf_td_be_mdu_slots =
+      static_cast<uint64_t>(top->perf_td_be_mdu_slots_o);
+  snap.perf_td_be_csr_slots =
+      static_cast<uint64_t>(top->perf_td_be_csr_slots_o);
+  snap.perf_td_be_other_slots =
+      static_cast<uint64_t>(top->perf_td_be_other_slots_o);
+}
 
+namespace {
+void collect_frontend(const Vtb_triathlon *top, Snapshot &snap) {
+  snap.dbg_fe_valid = static_cast<uint8_t>(top->dbg_fe_valid_o);
+  snap.dbg_fe_ready = static_cast<uint8_t>(top->dbg_fe_ready_o);
+  snap.dbg_fe_pc = static_cast<uint32_t>(top->dbg_fe_pc_o);
+  for (int i = 0; i < 4; i++) {
+    snap.dbg_fe_instrs[i] = static_cast<uint32_t>(top->dbg_fe_instrs_o[i]);
+  }
+}
+
+void collect_bru(const Vtb_triathlon *top, Snapshot &snap) {
+  snap.backend_flush = static_cast<uint8_t>(top->backend_flush_o);
+  snap.backend_redirect_pc = static_cast<uint32_t>(top->backend_redirect_pc_o);
+  snap.dbg_bru_valid = static_cast<uint8_t>(top->dbg_bru_valid_o);
+  snap.dbg_bru_mispred = static_cast<uint8_t>(top->dbg_bru_mispred_o);
+  snap.dbg_bru_pc = static_cast<uint32_t>(top->dbg_bru_pc_o);
+  snap.dbg_bru_imm = static_cast<uint32_t>(top->dbg_bru_imm_o);
+  snap.dbg_bru_op = static_cast<uint32_t>(top->dbg_bru_op_o);
+  snap.dbg_bru_is_jump = static_cast<uint8_t>(top->dbg_bru_is_jump_o);
+  snap.dbg_bru_is_branch = static_cast<uint8_t>(top->dbg_bru_is_branch_o);
+}
+
+void collect_rob(const Vtb_triathlon *top, Snapshot &snap) {
+  snap.dbg_rob_head_fu = static_cast<uint32_t>(top->dbg_rob_head_fu_o);
+  snap.dbg_rob_head_complete = static_cast<uint8_t>(top->dbg_rob_head_complete_o);
+  snap.dbg_rob_head_is_store = static_cast<uint8_t>(top->dbg_rob_head_is_store_o);
+  snap.dbg_rob_head_pc = static_cast<uint32_t>(top->dbg_rob_head_pc_o);
+  snap.dbg_rob_count = static_cast<uint32_t>(top->dbg_rob_count_o);
+  snap.dbg_rob_head_ptr = static_cast<uint32_t>(top->dbg_rob_head_ptr_o);
+  snap.dbg_rob_tail_ptr = static_cast<uint32_t>(top->dbg_rob_tail_ptr_o);
+
+  snap.dbg_rob_q2_valid = static_cast<uint8_t>(top->dbg_rob_q2_valid_o);
+  snap.dbg_rob_q2_idx = static_cast<uint32_t>(top->dbg_rob_q2_idx_o);
+  snap.dbg_rob_q2_fu = static_cast<uint32_t>(top->dbg_rob_q2_fu_o);
+  snap.dbg_rob_q2_complete = static_cast<uint8_t>(top->dbg_rob_q2_complete_o);
+  snap.dbg_rob_q2_is_store = static_cast<uint8_t>(top->dbg_rob_q2_is_store_o);
+  snap.dbg_rob_q2_pc = static_cast<uint32_t>(top->dbg_rob_q2_pc_o);
+
+  snap.dbg_sb_count = static_cast<uint32_t>(top->dbg_sb_count_o);
+  snap.dbg_sb_head_ptr = static_cast<uint32_t>(top->dbg_sb_head_ptr_o);
+  snap.dbg_sb_tail_ptr = static_cast<uint32_t>(top->dbg_sb_tail_ptr_o);
+  snap.dbg_sb_head_valid = static_cast<uint8_t>(top->dbg_sb_head_valid_o);
+  snap.dbg_sb_head_committed = static_cast<uint8_t>(top->dbg_sb_head_committed_o);
+  snap.dbg_sb_head_addr_valid = static_cast<uint8_t>(top->dbg_sb_head_addr_valid_o);
+  snap.dbg_sb_head_data_valid = static_cast<uint8_t>(top->dbg_sb_head_data_valid_o);
+  snap.dbg_sb_head_addr = static_cast<uint32_t>(top->dbg_sb_head_addr_o);
+}
+
+void collect_lsu(const Vtb_triathlon *top, Snapshot &snap) {
+  snap.dbg_dec_valid = static_cast<uint8_t>(top->dbg_dec_valid_o);
+  snap.dbg_dec_ready = static_cast<uint8_t>(top->dbg_dec_ready_o);
+  snap.dbg_rob_ready = static_cast<uint8_t>(top->dbg_rob_ready_o);
+
+  snap.dbg_lsu_ld_req_valid = static_cast<uint8_t>(top->dbg_lsu_ld_req_valid_o);
+  snap.dbg_lsu_ld_req_ready = static_cast<uint8_t>(top->dbg_lsu_ld_req_ready_o);
+  snap.dbg_lsu_ld_req_addr = static_cast<uint32_t>(top->dbg_lsu_ld_req_addr_o);
+  snap.dbg_lsu_ld_rsp_valid = static_cast<uint8_t>(top->dbg_lsu_ld_rsp_valid_o);
+  snap.dbg_lsu_ld_rsp_ready = static_cast<uint8_t>(top->dbg_lsu_ld_rsp_ready_o);
+
+  snap.dbg_lsu_issue_valid = static_cast<uint8_t>(top->dbg_lsu_issue_valid_o);
+  snap.dbg_lsu_req_ready = static_cast<uint8_t>(top->dbg_lsu_req_ready_o);
+  snap.dbg_lsu_issue_ready = static_cast<uint8_t>(top->dbg_lsu_issue_ready_o);
+  snap.dbg_lsu_free_count = static_cast<uint32_t>(top->dbg_lsu_free_count_o);
+
+  snap.dbg_lsu_rs_busy = static_cast<uint32_t>(top->dbg_lsu_rs_busy_o);
+  snap.dbg_lsu_rs_ready = static_cast<uint32_t>(top->dbg_lsu_rs_ready_o);
+  snap.dbg_lsu_rs_head_valid = static_cast<uint8_t>(top->dbg_lsu_rs_head_valid_o);
+  snap.dbg_lsu_rs_head_idx = static_cast<uint32_t>(top->dbg_lsu_rs_head_idx_o);
+  snap.dbg_lsu_rs_head_dst = static_cast<uint32_t>(top->dbg_lsu_rs_head_dst_o);
+  snap.dbg_lsu_rs_head_r1_ready = static_cast<uint8_t>(top->dbg_lsu_rs_head_r1_ready_o);
+  snap.dbg_lsu_rs_head_r2_ready = static_cast<uint8_t>(top->dbg_lsu_rs_head_r2_ready_o);
+  snap.dbg_lsu_rs_head_has_rs1 = static_cast<uint8_t>(top->dbg_lsu_rs_head_has_rs1_o);
+  snap.dbg_lsu_rs_head_has_rs2 = static_cast<uint8_t>(top->dbg_lsu_rs_head_has_rs2_o);
+  snap.dbg_lsu_rs_head_q1 = static_cast<uint32_t>(top->dbg_lsu_rs_head_q1_o);
+  snap.dbg_lsu_rs_head_q2 = static_cast<uint32_t>(top->dbg_lsu_rs_head_q2_o);
+  snap.dbg_lsu_rs_head_sb_id = static_cast<uint32_t>(top->dbg_lsu_rs_head_sb_id_o);
+  snap.dbg_lsu_rs_head_is_load = static_cast<uint8_t>(top->dbg_lsu_rs_head_is_load_o);
+  snap.dbg_lsu_rs_head_is_store = static_cast<uint8_t>(top->dbg_lsu_rs_head_is_store_o);
+
+  snap.dbg_sb_alloc_req = static_cast<uint32_t>(top->dbg_sb_alloc_req_o);
+  snap.dbg_sb_alloc_ready = static_cast<uint8_t>(top->dbg_sb_alloc_ready_o);
+  snap.dbg_sb_alloc_fire = static_cast<uint8_t>(top->dbg_sb_alloc_fire_o);
+
+  snap.dbg_sb_dcache_req_valid = static_cast<uint8_t>(top->dbg_sb_dcache_req_valid_o);
+  snap.dbg_sb_dcache_req_ready = static_cast<uint8_t>(top->dbg_sb_dcache_req_ready_o);
+  snap.dbg_sb_dcache_req_addr = static_cast<uint32_t>(top->dbg_sb_dcache_req_addr_o);
+
+  snap.icache_miss_req_valid = static_cast<uint8_t>(top->dbg_icache_miss_valid_o);
+  snap.icache_miss_req_ready = static_cast<uint8_t>(top->dbg_icache_miss_ready_o);
+  snap.dcache_miss_req_valid = static_cast<uint8_t>(top->dbg_dcache_miss_valid_o);
+  snap.dcache_miss_req_ready = static_cast<uint8_t>(top->dbg_dcache_miss_ready_o);
+}
+}  // namespace
+
+void collect_parts(const Vtb_triathlon *top, unsigned parts, Snapshot &snap) {
+  if (parts & kSnapFrontend) collect_frontend(top, snap);
+  if (parts & kSnapBru) collect_bru(top, snap);
+  if (parts & kSnapRob) collect_rob(top, snap);
+  if (parts & kSnapLsu) collect_lsu(top, snap);
+  if (parts & kSnapPerf) collect_perf(top, snap);
+}
+
+Snapshot collect_snapshot(const Vtb_triathlon *top,
+                          uint64_t cycles,
+                          uint64_t total_commits,
+                          uint64_t no_commit_cycles,
+                          uint32_t last_commit_pc,
+                          uint32_t last_commit_inst,
+                          uint32_t a0) {
+  Snapshot snap{};
+  snap.cycles = cycles;
+  snap.total_commits = total_commits;
+  snap.no_commit_cycles = no_commit_cycles;
+  snap.last_commit_pc = last_commit_pc;
+  snap.last_commit_inst = last_commit_inst;
+  snap.a0 = a0;
+  collect_parts(top, kSnapAll, snap);
   return snap;
 }
+
+void SnapshotView::begin(uint64_t cycles, uint64_t total_commits,
+                         uint64_t no_commit_cycles, uint32_t last_commit_pc,
+                         uint32_t last_commit_inst, uint32_t a0) {
+  snap_.cycles = cycles;
+  snap_.total_commits = total_commits;
+  snap_.no_commit_cycles = no_commit_cycles;
+  snap_.last_commit_pc = last_commit_pc;
+  snap_.last_commit_inst = last_commit_inst;
+  snap_.a0 = a0;
+  loaded_ = 0;
+}
+
+const Snapshot &SnapshotView::get(unsigned parts) {
+  unsigned missing = parts & ~loaded_;
+  if (missing) {
+    SimStats::Scope t(*stats_, SimStats::kSnapshot);
+    collect_parts(top_, missing, snap_);
+    loaded_ |= missing;
+  }
+  return snap_;
+}
+
+void for_each_counter(
+    const Snapshot &snap,
+    const std::function<void(const char *name, uint64_t value)> &fn) {
+#define NPC_COUNTER(f) fn(#f, static_cast<uint64_t>(snap.f))
+  NPC_COUNTER(perf_cycles);
+  NPC_COUNTER(perf_commit_cycles);
+  NPC_COUNTER(perf_commit_instrs);
+  NPC_COUNTER(perf_nocommit_cycles);
+  NPC_COUNTER(perf_fe_empty_cycles);
+  NPC_COUNTER(perf_fe_stall_cycles);
+  NPC_COUNTER(perf_dec_stall_cycles);
+  NPC_COUNTER(perf_rob_full_cycles);
+  NPC_COUNTER(perf_issue_full_cycles);
+  NPC_COUNTER(perf_alu_full_cycles);
+  NPC_COUNTER(perf_bru_full_cycles);
+  NPC_COUNTER(perf_lsu_full_cycles);
+  NPC_COUNTER(perf_csr_full_cycles);
+  NPC_COUNTER(perf_sb_full_cycles);
+  NPC_COUNTER(perf_icache_miss_cycles);
+  NPC_COUNTER(perf_dcache_miss_cycles);
+  NPC_COUNTER(perf_flush_cycles);
+  NPC_COUNTER(perf_icache_miss_reqs);
+  NPC_COUNTER(perf_dcache_miss_reqs);
+  NPC_COUNTER(perf_ifu_start_cycles);
+  NPC_COUNTER(perf_ifu_wait_icache_cycles);
+  NPC_COUNTER(perf_ifu_wait_ibuf_cycles);
+  NPC_COUNTER(perf_icache_idle_cycles);
+  NPC_COUNTER(perf_icache_lookup_cycles);
+  NPC_COUNTER(perf_icache_miss_req_cycles);
+  NPC_COUNTER(perf_icache_wait_refill_cycles);
+  NPC_COUNTER(perf_ic_stall_cycles);
+  NPC_COUNTER(perf_ic_stall_noready_cycles);
+  NPC_COUNTER(perf_ic_stall_respq_cycles);
+  NPC_COUNTER(perf_lsu_idle_cycles);
+  NPC_COUNTER(perf_lsu_ld_req_cycles);
+  NPC_COUNTER(perf_lsu_ld_rsp_cycles);
+  NPC_COUNTER(perf_lsu_resp_cycles);
+  NPC_COUNTER(perf_dcache_idle_cycles);
+  NPC_COUNTER(perf_dcache_lookup_cycles);
+  NPC_COUNTER(perf_dcache_store_write_cycles);
+  NPC_COUNTER(perf_dcache_wb_req_cycles);
+  NPC_COUNTER(perf_dcache_miss_req_cycles);
+  NPC_COUNTER(perf_dcache_wait_refill_cycles);
+  NPC_COUNTER(perf_dcache_resp_cycles);
+  NPC_COUNTER(perf_td_retire_slots);
+  NPC_COUNTER(perf_td_badspec_slots);
+  NPC_COUNTER(perf_td_fe_icache_slots);
+  NPC_COUNTER(perf_td_fe_other_slots);
+  NPC_COUNTER(perf_td_be_mem_slots);
+  NPC_COUNTER(perf_td_be_alu_slots);
+  NPC_COUNTER(perf_td_be_bru_slots);
+  NPC_COUNTER(perf_td_be_mdu_slots);
+  NPC_COUNTER(perf_td_be_csr_slots);
+  NPC_COUNTER(perf_td_be_other_slots);
+  NPC_COUNTER(mem_bytes_per_cycle);
+  NPC_COUNTER(mem_read_reqs);
+  NPC_COUNTER(mem_write_reqs);
+  NPC_COUNTER(mem_read_bytes);
+  NPC_COUNTER(mem_write_bytes);
+  NPC_COUNTER(mem_read_latency_sum);
+  NPC_COUNTER(mem_bus_busy_cycles);
+  NPC_COUNTER(mem_row_hits);
+  NPC_COUNTER(mem_row_misses);
+  NPC_COUNTER(l2_size_bytes);
+  NPC_COUNTER(l2_ihits);
+  NPC_COUNTER(l2_imisses);
+  NPC_COUNTER(l2_dhits);
+  NPC_COUNTER(l2_dmisses);
+  NPC_COUNTER(l2_wb_hits);
+  NPC_COUNTER(l2_wb_misses);
+  NPC_COUNTER(l2_evictions);
+  NPC_COUNTER(l2_dirty_evictions);
+  NPC_COUNTER(axi_reads);
+  NPC_COUNTER(axi_writes);
+  NPC_COUNTER(axi_r_beats);
+  NPC_COUNTER(axi_read_latency_sum);
+  NPC_COUNTER(axi_r_conflict_cycles);
+#undef NPC_COUNTER
+}
+
+// Every model field of `part`, one call per field, for the debugger's dumps.
+void for_each_field(
+    const Snapshot &snap, SnapshotPart part,
+    const std::function<void(const char *name, uint64_t value)> &fn) {
+#define NPC_FIELD(f) fn(#f, static_cast<uint64_t>(snap.f))
+  switch (part) {
+    case kSnapFrontend:
+      NPC_FIELD(dbg_fe_valid);
+      NPC_FIELD(dbg_fe_ready);
+      NPC_FIELD(dbg_fe_pc);
+      fn("dbg_fe_instrs[0]", snap.dbg_fe_instrs[0]);
+      fn("dbg_fe_instrs[1]", snap.dbg_fe_instrs[1]);
+      fn("dbg_fe_instrs[2]", snap.dbg_fe_instrs[2]);
+      fn("dbg_fe_instrs[3]", snap.dbg_fe_instrs[3]);
+      break;
+    case kSnapBru:
+      NPC_FIELD(backend_flush);
+      NPC_FIELD(backend_redirect_pc);
+      NPC_FIELD(dbg_bru_valid);
+      NPC_FIELD(dbg_bru_mispred);
+      NPC_FIELD(dbg_bru_pc);
+      NPC_FIELD(dbg_bru_imm);
+      NPC_FIELD(dbg_bru_op);
+      NPC_FIELD(dbg_bru_is_jump);
+      NPC_FIELD(dbg_bru_is_branch);
+      break;
+    case kSnapRob:
+      NPC_FIELD(dbg_rob_head_fu);
+      NPC_FIELD(dbg_rob_head_complete);
+      NPC_FIELD(dbg_rob_head_is_store);
+      NPC_FIELD(dbg_rob_head_pc);
+      NPC_FIELD(dbg_rob_count);
+      NPC_FIELD(dbg_rob_head_ptr);
+      NPC_FIELD(dbg_rob_tail_ptr);
+      NPC_FIELD(dbg_rob_q2_valid);
+      NPC_FIELD(dbg_rob_q2_idx);
+      NPC_FIELD(dbg_rob_q2_fu);
+      NPC_FIELD(dbg_rob_q2_complete);
+      NPC_FIELD(dbg_rob_q2_is_store);
+      NPC_FIELD(dbg_rob_q2_pc);
+      NPC_FIELD(dbg_sb_count);
+      NPC_FIELD(dbg_sb_head_ptr);
+      NPC_FIELD(dbg_sb_tail_ptr);
+      NPC_FIELD(dbg_sb_head_valid);
+      NPC_FIELD(dbg_sb_head_committed);
+      NPC_FIELD(dbg_sb_head_addr_valid);
+      NPC_FIELD(dbg_sb_head_data_valid);
+      NPC_FIELD(dbg_sb_head_addr);
+      break;
+    case kSnapLsu:
+      NPC_FIELD(dbg_dec_valid);
+      NPC_FIELD(dbg_dec_ready);
+      NPC_FIELD(dbg_rob_ready);
+      NPC_FIELD(dbg_lsu_ld_req_valid);
+      NPC_FIELD(dbg_lsu_ld_req_ready);
+      NPC_FIELD(dbg_lsu_ld_req_addr);
+      NPC_FIELD(dbg_lsu_ld_rsp_valid);
+      NPC_FIELD(dbg_lsu_ld_rsp_ready);
+      NPC_FIELD(dbg_lsu_issue_valid);
+      NPC_FIELD(dbg_lsu_req_ready);
+      NPC_FIELD(dbg_lsu_issue_ready);
+      NPC_FIELD(dbg_lsu_free_count);
+      NPC_FIELD(dbg_lsu_rs_busy);
+      NPC_FIELD(dbg_lsu_rs_ready);
+      NPC_FIELD(dbg_lsu_rs_head_valid);
+      NPC_FIELD(dbg_lsu_rs_head_idx);
+      NPC_FIELD(dbg_lsu_rs_head_dst);
+      NPC_FIELD(dbg_lsu_rs_head_r1_ready);
+      NPC_FIELD(dbg_lsu_rs_head_r2_ready);
+      NPC_FIELD(dbg_lsu_rs_head_has_rs1);
+      NPC_FIELD(dbg_lsu_rs_head_has_rs2);
+      NPC_FIELD(dbg_lsu_rs_head_q1);
+      NPC_FIELD(dbg_lsu_rs_head_q2);
+      NPC_FIELD(dbg_lsu_rs_head_sb_id);
+      NPC_FIELD(dbg_lsu_rs_head_is_load);
+      NPC_FIELD(dbg_lsu_rs_head_is_store);
+      NPC_FIELD(dbg_sb_alloc_req);
+      NPC_FIELD(dbg_sb_alloc_ready);
+      NPC_FIELD(dbg_sb_alloc_fire);
+      NPC_FIELD(dbg_sb_dcache_req_valid);
+      NPC_FIELD(dbg_sb_dcache_req_ready);
+      NPC_FIELD(dbg_sb_dcache_req_addr);
+      NPC_FIELD(icache_miss_req_valid);
+      NPC_FIELD(icache_miss_req_ready);
+      NPC_FIELD(dcache_miss_req_valid);
+      NPC_FIELD(dcache_miss_req_ready);
+      break;
+    case kSnapPerf:
+      for_each_counter(snap, [&](const char *name, uint64_t value) {
+        if (std::strncmp(name, "perf_", 5) == 0) fn(name, value);
+      });
+      break;
+    default:
+      break;
+  }
+#undef NPC_FIELD
+}
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdint>
+#include <functional>
 
 struct Snapshot {
   uint64_t cycles = 0;
@@ -136,10 +137,61 @@ struct Snapshot {
   uint64_t perf_dcache_miss_req_cycles = 0;
   uint64_t perf_dcache_wait_refill_cycles = 0;
   uint64_t perf_dcache_resp_cycles = 0;
+  // Top-down retire slots; they sum to NRET * perf_cycles.
+  uint64_t perf_td_retire_slots = 0;
+  uint64_t perf_td_badspec_slots = 0;
+  uint64_t perf_td_fe_icache_slots = 0;
+  uint64_t perf_td_fe_other_slots = 0;
+  uint64_t perf_td_be_mem_slots = 0;
+  uint64_t perf_td_be_alu_slots = 0;
+  uint64_t perf_td_be_bru_slots = 0;
+  uint64_t perf_td_be_mdu_slots = 0;
+  uint64_t perf_td_be_csr_slots = 0;
+  uint64_t perf_td_be_other_slots = 0;
+
+  // Harness memory timing model (filled by the caller, not collect_snapshot).
+  const char *mem_model = "";
+  uint32_t mem_bytes_per_cycle = 0;
+  uint64_t mem_read_reqs = 0;
+  uint64_t mem_write_reqs = 0;
+  uint64_t mem_read_bytes = 0;
+  uint64_t mem_write_bytes = 0;
+  uint64_t mem_read_latency_sum = 0;
+  uint64_t mem_bus_busy_cycles = 0;
+  uint64_t mem_row_hits = 0;
+  uint64_t mem_row_misses = 0;
+  // Optional L2 (csrc/mem/l2_cache.h); size 0 when disabled.
+  uint32_t l2_size_bytes = 0;
+  uint64_t l2_ihits = 0;
+  uint64_t l2_imisses = 0;
+  uint64_t l2_dhits = 0;
+  uint64_t l2_dmisses = 0;
+  uint64_t l2_wb_hits = 0;
+  uint64_t l2_wb_misses = 0;
+  uint64_t l2_evictions = 0;
+  uint64_t l2_dirty_evictions = 0;
+  // MEM_IF=axi slave (csrc/mem/axi_slave.h); zero on the refill ports.
+  uint64_t axi_reads = 0;
+  uint64_t axi_writes = 0;
+  uint64_t axi_r_beats = 0;
+  uint64_t axi_read_latency_sum = 0;
+  uint64_t axi_r_conflict_cycles = 0;
 };
 
 struct Vtb_triathlon;
+class SimStats;
+
+// Groups of model outputs, so a log line reads only what it prints.
+enum SnapshotPart : unsigned {
+  kSnapFrontend = 1u << 0,  // dbg_fe_*
+  kSnapBru = 1u << 1,       // backend flush/redirect, dbg_bru_*
+  kSnapRob = 1u << 2,       // ROB head/q2 and store buffer state
+  kSnapLsu = 1u << 3,       // decode/LSU/RS handshakes, cache miss requests
+  kSnapPerf = 1u << 4,      // perf_* counters
+  kSnapAll = (1u << 5) - 1,
+};
 
+// Full snapshot, for end-of-run reports.
 Snapshot collect_snapshot(const Vtb_triathlon *top,
                           uint64_t cycles,
                           uint64_t total_commits,
@@ -147,3 +199,42 @@ Snapshot collect_snapshot(const Vtb_triathlon *top,
                           uint32_t last_commit_pc,
                           uint32_t last_commit_inst,
                           uint32_t a0);
+
+// Refreshes only the perf_* counters; cheap enough to call every interval.
+void collect_perf(const Vtb_triathlon *top, Snapshot &snap);
+
+// Reads the model outputs of `parts` (SnapshotPart bits) into `snap`.
+void collect_parts(const Vtb_triathlon *top, unsigned parts, Snapshot &snap);
+
+// Per-cycle snapshot that reads each part from the model on first use, so
+// logging that ends up printing nothing costs no model reads.
+class SnapshotView {
+ public:
+  SnapshotView(const Vtb_triathlon *top, SimStats &stats)
+      : top_(top), stats_(&stats) {}
+
+  // Starts a new cycle; only the harness-side fields are set.
+  void begin(uint64_t cycles, uint64_t total_commits,
+             uint64_t no_commit_cycles, uint32_t last_commit_pc,
+             uint32_t last_commit_inst, uint32_t a0);
+  // Harness-side fields (cycles, commits, last_commit_*, a0) only.
+  const Snapshot &base() const { return snap_; }
+  const Snapshot &get(unsigned parts);
+
+ private:
+  const Vtb_triathlon *top_;
+  SimStats *stats_;
+  Snapshot snap_{};
+  unsigned loaded_ = 0;
+};
+
+// Visits every perf_* and mem_* counter as ("perf_cycles", value), ...
+void for_each_counter(
+    const Snapshot &snap,
+    const std::function<void(const char *name, uint64_t value)> &fn);
+
+// Visits the model fields read for one SnapshotPart, e.g. ("dbg_rob_count",
+// 12); kSnapPerf visits the perf_* counters.
+void for_each_field(
+    const Snapshot &snap, SnapshotPart part,
+    const std::function<void(const char *name, uint64_t value)> &fn);
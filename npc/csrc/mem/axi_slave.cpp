@@ -0,0 +1,262 @@
+#include "mem/axi_slave.h"
+
+#ifdef NPC_AXI
+
+#include <algorithm>
+
+#include "Vtb_triathlon.h"
+#include "checkpoint/serialize.h"
+
+namespace {
+constexpr uint32_t kBeatWords = 2;  // 64-bit data bus
+constexpr uint32_t kBeatsPerLine = UnifiedMem::kLineWords / kBeatWords;
+
+uint32_t line_base(uint32_t addr) {
+  return addr & ~(UnifiedMem::kLineBytes - 1);
+}
+
+uint64_t beat_of(const UnifiedMem::Line &line, uint32_t beat) {
+  uint32_t w = (beat % kBeatsPerLine) * kBeatWords;
+  return static_cast<uint64_t>(line[w]) |
+         (static_cast<uint64_t>(line[w + 1]) << 32);
+}
+
+template <typename T>
+void put_vector(VerilatedSerialize &os, const std::vector<T> &v) {
+  uint32_t n = static_cast<uint32_t>(v.size());
+  ckpt_put(os, n);
+  for (const T &e : v) ckpt_put(os, e);
+}
+
+template <typename T>
+void get_vector(VerilatedDeserialize &is, std::vector<T> &v) {
+  uint32_t n = 0;
+  ckpt_get(is, n);
+  v.resize(n);
+  for (T &e : v) ckpt_get(is, e);
+}
+}  // namespace
+
+void AxiSlave::configure(const AxiSlaveConfig &cfg) {
+  cfg_ = cfg;
+  cfg_.beat_cycles = std::max<uint32_t>(cfg_.beat_cycles, 1);
+  cfg_.outstanding = std::max<uint32_t>(cfg_.outstanding, 1);
+}
+
+void AxiSlave::reset() {
+  m_ = MasterOut{};
+  out_ = SlaveOut{};
+  reads_.clear();
+  write_ = Write{};
+  resps_.clear();
+  r_bus_free_at_ = 0;
+  w_free_at_ = 0;
+  last_grant_ = kNumPorts - 1;
+  stats_ = AxiSlaveStats{};
+}
+
+void AxiSlave::drive(Vtb_triathlon *top) const {
+  top->icache_arready_i = out_.arready[kICache];
+  top->icache_rvalid_i = out_.r[kICache].valid;
+  top->icache_rid_i = out_.r[kICache].id;
+  top->icache_rdata_i = out_.r[kICache].data;
+  top->icache_rresp_i = 0;
+  top->icache_rlast_i = out_.r[kICache].last;
+
+  top->dcache_arready_i = out_.arready[kDCache];
+  top->dcache_rvalid_i = out_.r[kDCache].valid;
+  top->dcache_rid_i = out_.r[kDCache].id;
+  top->dcache_rdata_i = out_.r[kDCache].data;
+  top->dcache_rresp_i = 0;
+  top->dcache_rlast_i = out_.r[kDCache].last;
+
+  top->dcache_awready_i = out_.awready;
+  top->dcache_wready_i = out_.wready;
+  top->dcache_bvalid_i = out_.bvalid;
+  top->dcache_bid_i = out_.bid;
+  top->dcache_bresp_i = 0;
+}
+
+void AxiSlave::sample(const Vtb_triathlon *top) {
+  m_.arvalid[kICache] = top->icache_arvalid_o;
+  m_.arid[kICache] = top->icache_arid_o;
+  m_.araddr[kICache] = top->icache_araddr_o;
+  m_.arlen[kICache] = top->icache_arlen_o;
+  m_.rready[kICache] = top->icache_rready_o;
+
+  m_.arvalid[kDCache] = top->dcache_arvalid_o;
+  m_.arid[kDCache] = top->dcache_arid_o;
+  m_.araddr[kDCache] = top->dcache_araddr_o;
+  m_.arlen[kDCache] = top->dcache_arlen_o;
+  m_.rready[kDCache] = top->dcache_rready_o;
+
+  m_.awvalid = top->dcache_awvalid_o;
+  m_.awid = top->dcache_awid_o;
+  m_.awaddr = top->dcache_awaddr_o;
+  m_.awlen = top->dcache_awlen_o;
+  m_.wvalid = top->dcache_wvalid_o;
+  m_.wdata = top->dcache_wdata_o;
+  m_.wlast = top->dcache_wlast_o;
+  m_.bready = top->dcache_bready_o;
+}
+
+AxiSlave::Read *AxiSlave::front_read(int port) {
+  for (Read &r : reads_) {
+    if (r.port == port) return &r;
+  }
+  return nullptr;
+}
+
+uint32_t AxiSlave::inflight() const {
+  return static_cast<uint32_t>(reads_.size() + resps_.size()) +
+         (write_.active ? 1u : 0u);
+}
+
+// Transfers that happened at the rising edge just simulated.
+void AxiSlave::handshake(uint64_t now) {
+  for (int p = 0; p < kNumPorts; p++) {
+    if (out_.r[p].valid && m_.rready[p]) {
+      out_.r[p].valid = false;
+      stats_.r_beats++;
+      Read *r = front_read(p);
+      if (r && ++r->next_beat == r->beats) {
+        stats_.read_latency_sum += now - r->accepted_at;
+        reads_.erase(reads_.begin() + (r - reads_.data()));
+      }
+    }
+    if (out_.arready[p] && m_.arvalid[p]) {
+      Read r{};
+      r.port = static_cast<uint8_t>(p);
+      r.id = m_.arid[p];
+      r.beats = static_cast<uint8_t>(m_.arlen[p] + 1);
+      r.addr = m_.araddr[p];
+      r.accepted_at = now;
+      if (DeviceBus::in_mmio(r.addr)) {
+        if (devices) {
+          r.line[UnifiedMem::line_word(r.addr)] = devices->read(r.addr);
+        }
+        r.ready_at = now + DeviceBus::kLatency;
+      } else {
+        if (mem) mem->fill_line(line_base(r.addr), r.line);
+        r.ready_at = now;
+        if (l2) {
+          r.ready_at = l2->read(now, line_base(r.addr),
+                                p == kICache ? L2Cache::kICache
+                                             : L2Cache::kDCache);
+        }
+      }
+      r.ready_at += cfg_.read_latency;
+      reads_.push_back(r);
+      stats_.reads++;
+    }
+  }
+
+  if (out_.bvalid && m_.bready) {
+    out_.bvalid = false;
+    resps_.erase(resps_.begin());
+  }
+  if (out_.wready && m_.wvalid) {
+    write_.line[(write_.next_beat % kBeatsPerLine) * kBeatWords] =
+        static_cast<uint32_t>(m_.wdata);
+    write_.line[(write_.next_beat % kBeatsPerLine) * kBeatWords + 1] =
+        static_cast<uint32_t>(m_.wdata >> 32);
+    write_.next_beat++;
+    w_free_at_ = now + cfg_.beat_cycles - 1;
+    if (m_.wlast || write_.next_beat == write_.beats) {
+      uint64_t done;
+      if (DeviceBus::in_mmio(write_.addr)) {
+        uint32_t data = write_.line[UnifiedMem::line_word(write_.addr)];
+        if (devices) devices->write(write_.addr, data);
+        done = now + DeviceBus::kLatency;
+      } else {
+        if (mem) mem->write_line(line_base(write_.addr), write_.line);
+        done = l2 ? l2->write(now, line_base(write_.addr)) : now;
+      }
+      resps_.push_back(Resp{write_.id, done + cfg_.write_latency});
+      write_.active = false;
+      stats_.writes++;
+    }
+  }
+  if (out_.awready && m_.awvalid) {
+    write_ = Write{};
+    write_.active = true;
+    write_.id = m_.awid;
+    write_.beats = static_cast<uint8_t>(m_.awlen + 1);
+    write_.addr = m_.awaddr;
+  }
+}
+
+// What the slave presents at the next rising edge.
+void AxiSlave::schedule_outputs(uint64_t now) {
+  uint32_t n = inflight();
+  for (int p = 0; p < kNumPorts; p++) {
+    out_.arready[p] = m_.arvalid[p] && n < cfg_.outstanding;
+    if (out_.arready[p]) n++;
+  }
+  out_.awready = m_.awvalid && !write_.active && n < cfg_.outstanding;
+  out_.wready = write_.active && now >= w_free_at_;
+
+  // A beat stays on its port until taken; the bus is re-granted every
+  // beat_cycles, round-robin between the ports with data ready.
+  if (now >= r_bus_free_at_) {
+    int ready[kNumPorts];
+    int num_ready = 0;
+    for (int i = 1; i <= kNumPorts; i++) {
+      int p = (last_grant_ + i) % kNumPorts;
+      if (out_.r[p].valid) continue;
+      const Read *r = front_read(p);
+      if (r && now >= r->ready_at) ready[num_ready++] = p;
+    }
+    if (num_ready > 0) {
+      int p = ready[0];
+      const Read *r = front_read(p);
+      out_.r[p] = Beat{true, r->id,
+                       static_cast<uint8_t>(r->next_beat + 1) == r->beats,
+                       beat_of(r->line, r->next_beat)};
+      last_grant_ = p;
+      r_bus_free_at_ = now + cfg_.beat_cycles;
+      if (num_ready > 1) stats_.r_conflict_cycles++;
+    }
+  }
+
+  if (!out_.bvalid && !resps_.empty() && now >= resps_.front().ready_at) {
+    out_.bvalid = true;
+    out_.bid = resps_.front().id;
+  }
+}
+
+void AxiSlave::observe(Vtb_triathlon *top, uint64_t now) {
+  if (!top->rst_ni) {
+    reset();
+    return;
+  }
+  handshake(now);
+  sample(top);
+  schedule_outputs(now);
+}
+
+void AxiSlave::save(VerilatedSerialize &os) const {
+  ckpt_put(os, stats_);
+  ckpt_put(os, m_);
+  ckpt_put(os, out_);
+  put_vector(os, reads_);
+  ckpt_put(os, write_);
+  put_vector(os, resps_);
+  ckpt_put(os, r_bus_free_at_);
+  ckpt_put(os, w_free_at_);
+  ckpt_put(os, last_grant_);
+}
+
+void AxiSlave::restore(VerilatedDeserialize &is) {
+  ckpt_get(is, stats_);
+  ckpt_get(is, m_);
+  ckpt_get(is, out_);
+  get_vector(is, reads_);
+  ckpt_get(is, write_);
+  get_vector(is, resps_);
+  ckpt_get(is, r_bus_free_at_);
+  ckpt_get(is, w_free_at_);
+  ckpt_get(is, last_grant_);
+}
+
+#endif  // NPC_AXI
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "device/device.h"
+#include "mem/l2_cache.h"
+#include "mem/unified_mem.h"
+
+struct Vtb_triathlon;
+class VerilatedSerialize;
+class VerilatedDeserialize;
+
+// Interconnect parameters of the AXI4 slave, in core cycles.
+struct AxiSlaveConfig {
+  // Added to the L2 / memory access time before the first R beat / the B
+  // response.
+  uint32_t read_latency = 0;
+  uint32_t write_latency = 0;
+  // Cycles one 64-bit beat occupies the shared R bus (or the W channel).
+  uint32_t beat_cycles = 1;
+  // Transactions (reads, writes and unsent write responses) in flight before
+  // the slave stops accepting AR/AW.
+  uint32_t outstanding = 4;
+};
+
+struct AxiSlaveStats {
+  uint64_t reads = 0;
+  uint64_t writes = 0;
+  uint64_t r_beats = 0;
+  // AR accepted to last R beat accepted.
+  uint64_t read_latency_sum = 0;
+  // Cycles a port had a beat ready but the R bus went to the other port.
+  uint64_t r_conflict_cycles = 0;
+};
+
+// AXI4 slave behind the I$ (read-only, port 0) and D$ (port 1) masters of
+// the MEM_IF=axi tb_triathlon. Bursts are served a line at a time: the data
+// is read when AR is accepted, and the beats of the line containing the
+// address follow once the L2 / memory timing and read_latency have passed.
+// Both ports share one R bus, granted round-robin one beat at a time, so
+// concurrent I$ and D$ refills interleave. Writes are applied on the last W
+// beat and answered after the write time. Device-region accesses go to the
+// device bus and only touch the word lane of their address, as on the
+// refill ports.
+//
+// The master channel outputs are registered (vsrc/cache/*_axi_master.sv),
+// so what observe() reads after a rising edge is what the masters present
+// at the next one; handshakes are resolved one cycle later against what
+// drive() put on the inputs.
+class AxiSlave {
+ public:
+  enum Port { kICache, kDCache, kNumPorts };
+
+  UnifiedMem *mem = nullptr;
+  L2Cache *l2 = nullptr;
+  DeviceBus *devices = nullptr;
+
+  void configure(const AxiSlaveConfig &cfg);
+  void reset();
+  void drive(Vtb_triathlon *top) const;
+  void observe(Vtb_triathlon *top, uint64_t now);
+  // Channel state and in-flight bursts; the config is taken from the
+  // command line like MemTiming's.
+  void save(VerilatedSerialize &os) const;
+  void restore(VerilatedDeserialize &is);
+
+  const AxiSlaveConfig &config() const { return cfg_; }
+  const AxiSlaveStats &stats() const { return stats_; }
+
+ private:
+  // Master outputs presented at the next rising edge.
+  struct MasterOut {
+    bool arvalid[kNumPorts];
+    uint8_t arid[kNumPorts];
+    uint32_t araddr[kNumPorts];
+    uint8_t arlen[kNumPorts];
+    bool rready[kNumPorts];
+    bool awvalid;
+    uint8_t awid;
+    uint32_t awaddr;
+    uint8_t awlen;
+    bool wvalid;
+    uint64_t wdata;
+    bool wlast;
+    bool bready;
+  };
+  struct Beat {
+    bool valid;
+    uint8_t id;
+    bool last;
+    uint64_t data;
+  };
+  // Slave outputs driven for the next rising edge.
+  struct SlaveOut {
+    bool arready[kNumPorts];
+    Beat r[kNumPorts];
+    bool awready;
+    bool wready;
+    bool bvalid;
+    uint8_t bid;
+  };
+  struct Read {
+    uint8_t port;
+    uint8_t id;
+    uint8_t beats;
+    uint8_t next_beat;
+    uint32_t addr;
+    uint64_t accepted_at;
+    uint64_t ready_at;
+    UnifiedMem::Line line;
+  };
+  struct Write {
+    bool active;
+    uint8_t id;
+    uint8_t beats;
+    uint8_t next_beat;
+    uint32_t addr;
+    UnifiedMem::Line line;
+  };
+  struct Resp {
+    uint8_t id;
+    uint64_t ready_at;
+  };
+
+  void sample(const Vtb_triathlon *top);
+  void handshake(uint64_t now);
+  void schedule_outputs(uint64_t now);
+  Read *front_read(int port);
+  uint32_t inflight() const;
+
+  AxiSlaveConfig cfg_{};
+  AxiSlaveStats stats_{};
+  MasterOut m_{};
+  SlaveOut out_{};
+  // Accepted reads, oldest first; each port's are returned in order.
+  std::vector<Read> reads_;
+  Write write_{};
+  std::vector<Resp> resps_;
+  uint64_t r_bus_free_at_ = 0;
+  uint64_t w_free_at_ = 0;
+  int last_grant_ = kNumPorts - 1;
+};
@@ -0,0 +1,150 @@
+#include "mem/l2_cache.h"
+
+#include "checkpoint/serialize.h"
+#include "mem/unified_mem.h"
+
+bool L2Config::parse_repl(const std::string &name, Repl &out) {
+  if (name == "lru") {
+    out = Repl::kLru;
+    return true;
+  }
+  if (name == "fifo") {
+    out = Repl::kFifo;
+    return true;
+  }
+  if (name == "random") {
+    out = Repl::kRandom;
+    return true;
+  }
+  return false;
+}
+
+const char *L2Config::repl_name() const {
+  switch (repl) {
+    case Repl::kFifo: return "fifo";
+    case Repl::kRandom: return "random";
+    default: return "lru";
+  }
+}
+
+void L2Cache::configure(const L2Config &cfg) {
+  cfg_ = cfg;
+  if (cfg_.ways == 0) cfg_.ways = 1;
+  num_sets_ = cfg_.size_bytes / (UnifiedMem::kLineBytes * cfg_.ways);
+  reset();
+}
+
+void L2Cache::reset() {
+  stats_ = L2Stats{};
+  lines_.assign(static_cast<size_t>(num_sets_) * cfg_.ways, Line{});
+  tick_ = 0;
+  rand_state_ = 1;
+}
+
+uint32_t L2Cache::set_of(uint32_t addr) const {
+  return (addr / UnifiedMem::kLineBytes) % num_sets_;
+}
+
+L2Cache::Line *L2Cache::lookup(uint32_t addr) {
+  uint32_t tag = addr / UnifiedMem::kLineBytes;
+  Line *set = &lines_[static_cast<size_t>(set_of(addr)) * cfg_.ways];
+  for (uint32_t w = 0; w < cfg_.ways; w++) {
+    if (set[w].valid && set[w].tag == tag) return &set[w];
+  }
+  return nullptr;
+}
+
+// Picks a victim in the line's set and writes it back if dirty; the
+// write is posted behind whatever was scheduled first.
+L2Cache::Line &L2Cache::allocate(uint64_t now, uint32_t addr, bool dirty) {
+  Line *set = &lines_[static_cast<size_t>(set_of(addr)) * cfg_.ways];
+  Line *victim = nullptr;
+  for (uint32_t w = 0; w < cfg_.ways && !victim; w++) {
+    if (!set[w].valid) victim = &set[w];
+  }
+  if (!victim) {
+    if (cfg_.repl == L2Config::Repl::kRandom) {
+      // xorshift32: reproducible across runs and checkpoints.
+      rand_state_ ^= rand_state_ << 13;
+      rand_state_ ^= rand_state_ >> 17;
+      rand_state_ ^= rand_state_ << 5;
+      victim = &set[rand_state_ % cfg_.ways];
+    } else {
+      victim = &set[0];
+      for (uint32_t w = 1; w < cfg_.ways; w++) {
+        if (set[w].stamp < victim->stamp) victim = &set[w];
+      }
+    }
+    stats_.evictions++;
+    if (victim->dirty) {
+      stats_.dirty_evictions++;
+      timing->schedule(now, victim->tag * UnifiedMem::kLineBytes,
+                       UnifiedMem::kLineBytes, true);
+    }
+  }
+  *victim = Line{true, dirty, addr / UnifiedMem::kLineBytes, ++tick_};
+  return *victim;
+}
+
+uint64_t L2Cache::read(uint64_t now, uint32_t addr, Requester who) {
+  if (!enabled()) {
+    return timing->schedule(now, addr, UnifiedMem::kLineBytes, false);
+  }
+  uint64_t looked_up = now + cfg_.latency;
+  if (Line *line = lookup(addr)) {
+    stats_.hits[who]++;
+    if (cfg_.repl == L2Config::Repl::kLru) line->stamp = ++tick_;
+    return looked_up;
+  }
+  stats_.misses[who]++;
+  uint64_t done =
+      timing->schedule(looked_up, addr, UnifiedMem::kLineBytes, false);
+  allocate(looked_up, addr, false);
+  return done;
+}
+
+uint64_t L2Cache::write(uint64_t now, uint32_t addr) {
+  if (!enabled()) {
+    return timing->schedule(now, addr, UnifiedMem::kLineBytes, true);
+  }
+  uint64_t looked_up = now + cfg_.latency;
+  if (Line *line = lookup(addr)) {
+    stats_.wb_hits++;
+    line->dirty = true;
+    if (cfg_.repl == L2Config::Repl::kLru) line->stamp = ++tick_;
+    return looked_up;
+  }
+  stats_.wb_misses++;
+  if (!cfg_.wb_allocate) {
+    return timing->schedule(looked_up, addr, UnifiedMem::kLineBytes, true);
+  }
+  allocate(looked_up, addr, true);
+  return looked_up;
+}
+
+void L2Cache::save(VerilatedSerialize &os) const {
+  ckpt_put(os, stats_);
+  ckpt_put(os, tick_);
+  ckpt_put(os, rand_state_);
+  uint32_t num_lines = static_cast<uint32_t>(lines_.size());
+  ckpt_put(os, num_sets_);
+  ckpt_put(os, num_lines);
+  for (const Line &line : lines_) ckpt_put(os, line);
+}
+
+void L2Cache::restore(VerilatedDeserialize &is) {
+  reset();
+  ckpt_get(is, stats_);
+  ckpt_get(is, tick_);
+  ckpt_get(is, rand_state_);
+  uint32_t num_sets = 0;
+  uint32_t num_lines = 0;
+  ckpt_get(is, num_sets);
+  ckpt_get(is, num_lines);
+  bool same = num_sets == num_sets_ && num_lines == lines_.size();
+  for (uint32_t i = 0; i < num_lines; i++) {
+    Line line;
+    ckpt_get(is, line);
+    if (same) lines_[i] = line;
+  }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mem/mem_timing.h"
+
+class VerilatedSerialize;
+class VerilatedDeserialize;
+
+// Geometry and policy of the optional L2 between the L1 miss ports and
+// memory. Lines are the L1 line size (UnifiedMem::kLineBytes).
+struct L2Config {
+  enum class Repl { kLru, kFifo, kRandom };
+
+  // 0 disables the L2.
+  uint32_t size_bytes = 0;
+  uint32_t ways = 8;
+  // Tag + data access, paid by hits and in front of every miss.
+  uint32_t latency = 10;
+  Repl repl = Repl::kLru;
+  // D$ writebacks that miss in the L2 allocate there; otherwise they go
+  // straight to memory.
+  bool wb_allocate = true;
+
+  static bool parse_repl(const std::string &name, Repl &out);
+  const char *repl_name() const;
+};
+
+struct L2Stats {
+  // Indexed by L2Cache::Requester.
+  uint64_t hits[2] = {};
+  uint64_t misses[2] = {};
+  uint64_t wb_hits = 0;
+  uint64_t wb_misses = 0;
+  uint64_t evictions = 0;
+  uint64_t dirty_evictions = 0;
+};
+
+// Timing-only shared L2: it tracks tags and dirty bits, while the data
+// stays in UnifiedMem. Refills that hit return after `latency`; misses pay
+// `latency` and then the memory access, and a dirty victim is written back
+// to memory behind the refill. D$ writebacks are posted and cost the cache
+// `latency` on a hit. A disabled L2 passes everything to MemTiming.
+//
+// The RTL L1s cannot be back-invalidated from the harness, so the L2 is
+// neither inclusive nor exclusive of them: an L2 victim may stay in an L1.
+class L2Cache {
+ public:
+  enum Requester { kICache, kDCache, kNumRequesters };
+
+  MemTiming *timing = nullptr;
+
+  void configure(const L2Config &cfg);
+  void reset();
+  bool enabled() const { return num_sets_ != 0; }
+
+  // Both return the cycle at which the line transfer has completed.
+  uint64_t read(uint64_t now, uint32_t addr, Requester who);
+  uint64_t write(uint64_t now, uint32_t addr);
+
+  // Tags and replacement state. A checkpoint restored into a different
+  // geometry starts with an empty L2.
+  void save(VerilatedSerialize &os) const;
+  void restore(VerilatedDeserialize &is);
+
+  const L2Config &config() const { return cfg_; }
+  const L2Stats &stats() const { return stats_; }
+
+ private:
+  struct Line {
+    bool valid;
+    bool dirty;
+    uint32_t tag;
+    uint64_t stamp;  // last use (LRU) or fill (FIFO)
+  };
+
+  Line *lookup(uint32_t addr);
+  Line &allocate(uint64_t now, uint32_t addr, bool dirty);
+  uint32_t set_of(uint32_t addr) const;
+
+  L2Config cfg_{};
+  L2Stats stats_{};
+  uint32_t num_sets_ = 0;
+  std::vector<Line> lines_;  // num_sets_ x ways
+  uint64_t tick_ = 0;
+  uint32_t rand_state_ = 1;
+};
@@ -0,0 +1,249 @@
+#include "mem/mem_system.h"
+
+#include "Vtb_triathlon.h"
+#include "checkpoint/serialize.h"
+
+#ifndef NPC_AXI
+void ICacheModel::reset() {
+  pending = false;
+  ready_at = 0;
+  miss_addr = 0;
+  miss_way = 0;
+  refill_pulse = false;
+}
+
+void ICacheModel::drive(Vtb_triathlon *top) {
+  top->icache_miss_req_ready_i = 1;
+  if (refill_pulse) {
+    top->icache_refill_valid_i = 1;
+    top->icache_refill_paddr_i = miss_addr;
+    top->icache_refill_way_i = miss_way;
+    for (int i = 0; i < 8; i++) top->icache_refill_data_i[i] = line_words[i];
+  } else {
+    top->icache_refill_valid_i = 0;
+    top->icache_refill_paddr_i = 0;
+    top->icache_refill_way_i = 0;
+    for (int i = 0; i < 8; i++) top->icache_refill_data_i[i] = 0;
+  }
+}
+
+void ICacheModel::observe(Vtb_triathlon *top, uint64_t now) {
+  if (!top->rst_ni) {
+    reset();
+    return;
+  }
+
+  if (refill_pulse) {
+    refill_pulse = false;
+  }
+
+  if (!pending && top->icache_miss_req_valid_o) {
+    pending = true;
+    miss_addr = top->icache_miss_req_paddr_o;
+    miss_way = top->icache_miss_req_victim_way_o;
+    if (mem) mem->fill_line(miss_addr, line_words);
+    ready_at = l2->read(now, miss_addr, L2Cache::kICache);
+  }
+
+  if (pending && now >= ready_at && top->icache_refill_ready_o) {
+    refill_pulse = true;
+    pending = false;
+  }
+}
+
+void ICacheModel::save(VerilatedSerialize &os) const {
+  ckpt_put(os, pending);
+  ckpt_put(os, ready_at);
+  ckpt_put(os, miss_addr);
+  ckpt_put(os, miss_way);
+  ckpt_put(os, refill_pulse);
+  ckpt_put(os, line_words);
+}
+
+void ICacheModel::restore(VerilatedDeserialize &is) {
+  ckpt_get(is, pending);
+  ckpt_get(is, ready_at);
+  ckpt_get(is, miss_addr);
+  ckpt_get(is, miss_way);
+  ckpt_get(is, refill_pulse);
+  ckpt_get(is, line_words);
+}
+
+void DCacheModel::reset() {
+  pending = false;
+  ready_at = 0;
+  miss_addr = 0;
+  miss_way = 0;
+  refill_pulse = false;
+}
+
+void DCacheModel::drive(Vtb_triathlon *top) {
+  top->dcache_miss_req_ready_i = 1;
+  top->dcache_wb_req_ready_i = 1;
+  if (refill_pulse) {
+    top->dcache_refill_valid_i = 1;
+    top->dcache_refill_paddr_i = miss_addr;
+    top->dcache_refill_way_i = miss_way;
+    for (int i = 0; i < 8; i++) top->dcache_refill_data_i[i] = line_words[i];
+  } else {
+    top->dcache_refill_valid_i = 0;
+    top->dcache_refill_paddr_i = 0;
+    top->dcache_refill_way_i = 0;
+    for (int i = 0; i < 8; i++) top->dcache_refill_data_i[i] = 0;
+  }
+}
+
+void DCacheModel::observe(Vtb_triathlon *top, uint64_t now) {
+  if (!top->rst_ni) {
+    reset();
+    return;
+  }
+
+  if (refill_pulse) {
+    refill_pulse = false;
+  }
+
+  // Writeback first: the D$ drains a dirty victim before requesting the
+  // refill, so the refill queues behind it on the channel.
+  if (top->dcache_wb_req_valid_o && top->dcache_wb_req_ready_i) {
+    uint32_t wb_addr = top->dcache_wb_req_paddr_o;
+    if (DeviceBus::in_mmio(wb_addr)) {
+      uint32_t word = UnifiedMem::line_word(wb_addr);
+      uint32_t data = top->dcache_wb_req_data_o[word];
+      if (devices) devices->write(wb_addr, data);
+    } else {
+      UnifiedMem::Line wb_line{};
+      for (int i = 0; i < 8; i++) wb_line[i] = top->dcache_wb_req_data_o[i];
+      if (mem) mem->write_line(wb_addr, wb_line);
+      l2->write(now, wb_addr);
+    }
+  }
+
+  if (!pending && top->dcache_miss_req_valid_o) {
+    pending = true;
+    miss_addr = top->dcache_miss_req_paddr_o;
+    miss_way = top->dcache_miss_req_victim_way_o;
+    if (DeviceBus::in_mmio(miss_addr)) {
+      line_words.fill(0);
+      if (devices) {
+        uint32_t word = UnifiedMem::line_word(miss_addr);
+        line_words[word] = devices->read(miss_addr);
+      }
+      ready_at = now + DeviceBus::kLatency;
+    } else {
+      if (mem) mem->fill_line(miss_addr, line_words);
+      ready_at = l2->read(now, miss_addr, L2Cache::kDCache);
+    }
+  }
+
+  if (pending && now >= ready_at && top->dcache_refill_ready_o) {
+    refill_pulse = true;
+    pending = false;
+  }
+}
+
+void DCacheModel::save(VerilatedSerialize &os) const {
+  ckpt_put(os, pending);
+  ckpt_put(os, ready_at);
+  ckpt_put(os, miss_addr);
+  ckpt_put(os, miss_way);
+  ckpt_put(os, refill_pulse);
+  ckpt_put(os, line_words);
+}
+
+void DCacheModel::restore(VerilatedDeserialize &is) {
+  ckpt_get(is, pending);
+  ckpt_get(is, ready_at);
+  ckpt_get(is, miss_addr);
+  ckpt_get(is, miss_way);
+  ckpt_get(is, refill_pulse);
+  ckpt_get(is, line_words);
+}
+
+#endif  // NPC_AXI
+
+MemSystem::MemSystem() {
+  l2.timing = &timing;
+#ifdef NPC_AXI
+  axi.mem = &mem;
+  axi.l2 = &l2;
+  axi.devices = &devices;
+#else
+  icache.mem = &mem;
+  icache.l2 = &l2;
+  dcache.mem = &mem;
+  dcache.l2 = &l2;
+  dcache.devices = &devices;
+#endif
+}
+
+void MemSystem::configure(const MemTimingConfig &cfg) {
+  timing = MemTiming(cfg);
+}
+
+void MemSystem::configure_l2(const L2Config &cfg) { l2.configure(cfg); }
+
+void MemSystem::configure_axi(const AxiSlaveConfig &cfg) {
+#ifdef NPC_AXI
+  axi.configure(cfg);
+#else
+  (void)cfg;
+#endif
+}
+
+void MemSystem::reset() {
+#ifdef NPC_AXI
+  axi.reset();
+#else
+  icache.reset();
+  dcache.reset();
+#endif
+  timing.reset();
+  l2.reset();
+  now = 0;
+}
+
+void MemSystem::drive(Vtb_triathlon *top) {
+#ifdef NPC_AXI
+  axi.drive(top);
+#else
+  icache.drive(top);
+  dcache.drive(top);
+#endif
+}
+
+void MemSystem::observe(Vtb_triathlon *top) {
+#ifdef NPC_AXI
+  axi.observe(top, now);
+#else
+  icache.observe(top, now);
+  dcache.observe(top, now);
+#endif
+  now++;
+}
+
+void MemSystem::save(VerilatedSerialize &os) const {
+  ckpt_put(os, now);
+  timing.save(os);
+  l2.save(os);
+#ifdef NPC_AXI
+  axi.save(os);
+#else
+  icache.save(os);
+  dcache.save(os);
+#endif
+  mem.save(os);
+}
+
+void MemSystem::restore(VerilatedDeserialize &is) {
+  ckpt_get(is, now);
+  timing.restore(is);
+  l2.restore(is);
+#ifdef NPC_AXI
+  axi.restore(is);
+#else
+  icache.restore(is);
+  dcache.restore(is);
+#endif
+  mem.restore(is);
+}
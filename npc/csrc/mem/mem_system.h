@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+
+#include "device/device.h"
+#include "mem/axi_slave.h"
+#include "mem/l2_cache.h"
+#include "mem/mem_timing.h"
+#include "mem/unified_mem.h"
+
+struct Vtb_triathlon;
+class VerilatedSerialize;
+class VerilatedDeserialize;
+
+// Line-granular refill model for the I$ miss/refill handshake of
+// tb_triathlon. The refill data is read when the miss is accepted and
+// returned once the L2 / memory timing model says the line has arrived.
+struct ICacheModel {
+  bool pending = false;
+  uint64_t ready_at = 0;
+  uint32_t miss_addr = 0;
+  uint32_t miss_way = 0;
+  bool refill_pulse = false;
+  UnifiedMem::Line line_words{};
+  UnifiedMem *mem = nullptr;
+  L2Cache *l2 = nullptr;
+
+  void reset();
+  void drive(Vtb_triathlon *top);
+  void observe(Vtb_triathlon *top, uint64_t now);
+  void save(VerilatedSerialize &os) const;
+  void restore(VerilatedDeserialize &is);
+};
+
+// Same as ICacheModel plus the D$ writeback port. Writebacks are applied to
+// memory immediately and only cost L2 or channel time in the timing model.
+// Uncached D$ accesses (device region) arrive on the same ports with a byte
+// address and go to the device bus instead, off the memory channel.
+struct DCacheModel {
+  bool pending = false;
+  uint64_t ready_at = 0;
+  uint32_t miss_addr = 0;
+  uint32_t miss_way = 0;
+  bool refill_pulse = false;
+  UnifiedMem::Line line_words{};
+  UnifiedMem *mem = nullptr;
+  L2Cache *l2 = nullptr;
+  DeviceBus *devices = nullptr;
+
+  void reset();
+  void drive(Vtb_triathlon *top);
+  void observe(Vtb_triathlon *top, uint64_t now);
+  void save(VerilatedSerialize &os) const;
+  void restore(VerilatedDeserialize &is);
+};
+
+// The memory behind tb_triathlon: the refill port models, or with
+// MEM_IF=axi (NPC_AXI) the AXI slave, on an optional L2 and one memory
+// timing model.
+struct MemSystem {
+  UnifiedMem mem;
+  MemTiming timing;
+  L2Cache l2;
+  DeviceBus devices;
+#ifdef NPC_AXI
+  AxiSlave axi;
+#else
+  ICacheModel icache;
+  DCacheModel dcache;
+#endif
+  uint64_t now = 0;
+
+  MemSystem();
+
+  void configure(const MemTimingConfig &cfg);
+  void configure_l2(const L2Config &cfg);
+  void configure_axi(const AxiSlaveConfig &cfg);
+  void reset();
+  void drive(Vtb_triathlon *top);
+  void observe(Vtb_triathlon *top);
+  // Memory contents, in-flight refills, L2 tags, channel state and the
+  // cycle count.
+  // Devices are owned by the caller and checkpointed separately.
+  void save(VerilatedSerialize &os) const;
+  void restore(VerilatedDeserialize &is);
+};
@@ -0,0 +1,113 @@
+#include "mem/mem_timing.h"
+
+#include <algorithm>
+
+#include "checkpoint/serialize.h"
+
+MemTimingConfig MemTimingConfig::preset(Kind kind) {
+  MemTimingConfig cfg{};
+  cfg.kind = kind;
+  if (kind == Kind::kDdr) {
+    // Roughly DDR3-1600 behind a ~100 MHz core: a 64-bit channel moves
+    // 8 bytes per core cycle once the row is open.
+    cfg.latency = 40;
+    cfg.row_hit_latency = 10;
+    cfg.row_miss_latency = 30;
+    cfg.num_banks = 8;
+    cfg.row_bytes = 2048;
+    cfg.bytes_per_cycle = 8;
+  }
+  return cfg;
+}
+
+bool MemTimingConfig::parse_kind(const std::string &name, Kind &out) {
+  if (name == "fixed") {
+    out = Kind::kFixed;
+    return true;
+  }
+  if (name == "ddr") {
+    out = Kind::kDdr;
+    return true;
+  }
+  return false;
+}
+
+const char *MemTimingConfig::kind_name() const {
+  return kind == Kind::kDdr ? "ddr" : "fixed";
+}
+
+MemTiming::MemTiming(const MemTimingConfig &cfg) : cfg_(cfg) {
+  if (cfg_.num_banks == 0) cfg_.num_banks = 1;
+  if (cfg_.row_bytes == 0) cfg_.row_bytes = 2048;
+  reset();
+}
+
+void MemTiming::reset() {
+  stats_ = MemTimingStats{};
+  banks_.assign(cfg_.num_banks, Bank{});
+  bus_free_at_ = 0;
+}
+
+uint64_t MemTiming::schedule(uint64_t now, uint32_t addr, uint32_t bytes,
+                             bool is_write) {
+  // The fixed latency is pipelined; only the bank access serialises.
+  uint64_t start = now + cfg_.latency;
+  Bank *bank = nullptr;
+  if (cfg_.kind == MemTimingConfig::Kind::kDdr) {
+    uint32_t row_addr = addr / cfg_.row_bytes;
+    bank = &banks_[row_addr % cfg_.num_banks];
+    uint32_t row = row_addr / cfg_.num_banks;
+    start = std::max(start, bank->ready_at);
+    if (bank->row_open && bank->open_row == row) {
+      start += cfg_.row_hit_latency;
+      stats_.row_hits++;
+    } else {
+      start += cfg_.row_miss_latency;
+      stats_.row_misses++;
+      bank->row_open = true;
+      bank->open_row = row;
+    }
+  }
+
+  uint64_t xfer = 0;
+  if (cfg_.bytes_per_cycle != 0) {
+    xfer = (bytes + cfg_.bytes_per_cycle - 1) / cfg_.bytes_per_cycle;
+  }
+  uint64_t data_start = std::max(start, bus_free_at_);
+  uint64_t done = data_start + xfer;
+  bus_free_at_ = done;
+  if (bank) bank->ready_at = done;
+  stats_.bus_busy_cycles += xfer;
+
+  if (is_write) {
+    stats_.write_reqs++;
+    stats_.write_bytes += bytes;
+  } else {
+    stats_.read_reqs++;
+    stats_.read_bytes += bytes;
+    stats_.read_latency_sum += done - now;
+  }
+  return done;
+}
+
+void MemTiming::save(VerilatedSerialize &os) const {
+  ckpt_put(os, stats_);
+  ckpt_put(os, bus_free_at_);
+  uint32_t num_banks = static_cast<uint32_t>(banks_.size());
+  ckpt_put(os, num_banks);
+  for (const Bank &bank : banks_) ckpt_put(os, bank);
+}
+
+void MemTiming::restore(VerilatedDeserialize &is) {
+  reset();
+  ckpt_get(is, stats_);
+  ckpt_get(is, bus_free_at_);
+  uint32_t num_banks = 0;
+  ckpt_get(is, num_banks);
+  for (uint32_t i = 0; i < num_banks; i++) {
+    Bank bank;
+    ckpt_get(is, bank);
+    // A different bank geometry starts with all rows closed.
+    if (num_banks == banks_.size()) banks_[i] = bank;
+  }
+}
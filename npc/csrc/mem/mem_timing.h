@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class VerilatedSerialize;
+class VerilatedDeserialize;
+
+// Timing parameters for the memory behind the L1 refill/writeback ports.
+// All latencies are in core cycles.
+struct MemTimingConfig {
+  enum class Kind { kFixed, kDdr };
+
+  Kind kind = Kind::kFixed;
+  // Fixed part of every access (controller + interconnect).
+  uint32_t latency = 2;
+  // kDdr only: extra latency when the bank's open row matches / misses.
+  uint32_t row_hit_latency = 0;
+  uint32_t row_miss_latency = 0;
+  uint32_t num_banks = 1;
+  uint32_t row_bytes = 2048;
+  // Data bus throughput. 0 means a whole line moves in the access cycle.
+  uint32_t bytes_per_cycle = 0;
+
+  static MemTimingConfig preset(Kind kind);
+  static bool parse_kind(const std::string &name, Kind &out);
+  const char *kind_name() const;
+};
+
+struct MemTimingStats {
+  uint64_t read_reqs = 0;
+  uint64_t write_reqs = 0;
+  uint64_t read_bytes = 0;
+  uint64_t write_bytes = 0;
+  uint64_t read_latency_sum = 0;
+  uint64_t bus_busy_cycles = 0;
+  uint64_t row_hits = 0;
+  uint64_t row_misses = 0;
+};
+
+// One memory channel shared by I$ refills, D$ refills and D$ writebacks.
+// Requests are scheduled when they are issued: each waits for its bank, pays
+// the access latency, then occupies the data bus for bytes/bytes_per_cycle
+// cycles. Writebacks are posted (the cache does not wait for them) but still
+// hold the bank and the bus, so they delay the refills queued behind them.
+class MemTiming {
+ public:
+  explicit MemTiming(const MemTimingConfig &cfg = MemTimingConfig{});
+
+  void reset();
+  // Returns the cycle at which the transfer issued at `now` has completed.
+  uint64_t schedule(uint64_t now, uint32_t addr, uint32_t bytes,
+                    bool is_write);
+
+  const MemTimingConfig &config() const { return cfg_; }
+
+  // Only the dynamic state is checkpointed; the config comes from the
+  // command line, so a phase can be re-run with a different memory model.
+  void save(VerilatedSerialize &os) const;
+  void restore(VerilatedDeserialize &is);
+  const MemTimingStats &stats() const { return stats_; }
+
+ private:
+  struct Bank {
+    bool row_open = false;
+    uint32_t open_row = 0;
+    uint64_t ready_at = 0;
+  };
+
+  MemTimingConfig cfg_;
+  MemTimingStats stats_{};
+  std::vector<Bank> banks_;
+  uint64_t bus_free_at_ = 0;
+};
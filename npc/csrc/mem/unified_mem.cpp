@@ -0,0 +1,152 @@
+#include "mem/unified_mem.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "checkpoint/serialize.h"
+
+UnifiedMem::UnifiedMem() {
+  void *p = mmap(nullptr, kPmemSize, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (p == MAP_FAILED) {
+    std::perror("mmap pmem");
+    std::abort();
+  }
+  pmem_ = static_cast<uint8_t *>(p);
+}
+
+UnifiedMem::~UnifiedMem() {
+  if (pmem_) munmap(pmem_, kPmemSize);
+}
+
+const uint8_t *UnifiedMem::find_page(uint32_t addr) const {
+  auto it = pages_.find(addr >> kPageBits);
+  if (it == pages_.end()) return nullptr;
+  return it->second->data() + (addr & (kPageSize - 1));
+}
+
+uint8_t *UnifiedMem::page_for(uint32_t addr) {
+  auto &page = pages_[addr >> kPageBits];
+  if (!page) page = std::make_unique<Page>(Page{});
+  return page->data() + (addr & (kPageSize - 1));
+}
+
+void UnifiedMem::read_bytes(uint32_t addr, void *dst, size_t n) const {
+  auto *out = static_cast<uint8_t *>(dst);
+  while (n > 0) {
+    size_t chunk =
+        std::min<size_t>(n, kPageSize - (addr & (kPageSize - 1)));
+    const uint8_t *p =
+        in_pmem(addr) ? pmem_ + (addr - kPmemBase) : find_page(addr);
+    if (p) {
+      std::memcpy(out, p, chunk);
+    } else {
+      std::memset(out, 0, chunk);
+    }
+    out += chunk;
+    addr += static_cast<uint32_t>(chunk);
+    n -= chunk;
+  }
+}
+
+void UnifiedMem::write_bytes(uint32_t addr, const void *src, size_t n) {
+  const auto *in = static_cast<const uint8_t *>(src);
+  while (n > 0) {
+    size_t chunk =
+        std::min<size_t>(n, kPageSize - (addr & (kPageSize - 1)));
+    uint8_t *p;
+    if (in_pmem(addr)) {
+      mark_dirty(addr - kPmemBase);
+      p = pmem_ + (addr - kPmemBase);
+    } else {
+      p = page_for(addr);
+    }
+    std::memcpy(p, in, chunk);
+    in += chunk;
+    addr += static_cast<uint32_t>(chunk);
+    n -= chunk;
+  }
+}
+
+bool UnifiedMem::load_binary(const std::string &path, uint32_t base) {
+  FILE *fp = std::fopen(path.c_str(), "rb");
+  if (!fp) {
+    std::cerr << "Failed to open IMG: " << path << "\n";
+    return false;
+  }
+  std::fseek(fp, 0, SEEK_END);
+  long size = std::ftell(fp);
+  std::fseek(fp, 0, SEEK_SET);
+  if (size < 0 || !in_pmem(base) ||
+      static_cast<uint64_t>(size) > kPmemSize - (base - kPmemBase)) {
+    std::cerr << "IMG does not fit in pmem: " << path << "\n";
+    std::fclose(fp);
+    return false;
+  }
+  size_t got = std::fread(pmem_ + (base - kPmemBase), 1,
+                          static_cast<size_t>(size), fp);
+  std::fclose(fp);
+  for (size_t off = 0; off < got; off += kPageSize) {
+    mark_dirty(static_cast<uint32_t>(base - kPmemBase + off));
+  }
+  if (got) mark_dirty(static_cast<uint32_t>(base - kPmemBase + got - 1));
+  if (got != static_cast<size_t>(size)) {
+    std::cerr << "Short read on IMG: " << path << "\n";
+    return false;
+  }
+  image_size_ = got;
+  return true;
+}
+
+void UnifiedMem::clear() {
+  // Anonymous private mapping: dropped pages fault back in as zero.
+  madvise(pmem_, kPmemSize, MADV_DONTNEED);
+  pages_.clear();
+  dirty_.fill(0);
+  image_size_ = 0;
+}
+
+void UnifiedMem::save(VerilatedSerialize &os) const {
+  std::vector<uint32_t> addrs;
+  for_each_dirty_page([&](uint32_t addr) { addrs.push_back(addr); });
+  for (const auto &[page_num, page] : pages_) {
+    addrs.push_back(page_num << kPageBits);
+  }
+
+  uint64_t image_size = image_size_;
+  uint32_t count = static_cast<uint32_t>(addrs.size());
+  ckpt_put(os, image_size);
+  ckpt_put(os, count);
+  Page buf;
+  for (uint32_t addr : addrs) {
+    read_bytes(addr, buf.data(), kPageSize);
+    ckpt_put(os, addr);
+    os.write(buf.data(), kPageSize);
+  }
+}
+
+void UnifiedMem::restore(VerilatedDeserialize &is) {
+  // Pages written since the checkpoint stay marked: they are zero again
+  // but may still differ in the difftest REF, which is synced from the
+  // dirty set after a restore.
+  std::array<uint64_t, kDirtyWords> dirty = dirty_;
+  clear();
+  uint64_t image_size = 0;
+  uint32_t count = 0;
+  ckpt_get(is, image_size);
+  ckpt_get(is, count);
+  Page buf;
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t addr = 0;
+    ckpt_get(is, addr);
+    is.read(buf.data(), kPageSize);
+    write_bytes(addr, buf.data(), kPageSize);
+  }
+  for (uint32_t w = 0; w < kDirtyWords; w++) dirty_[w] |= dirty[w];
+  image_size_ = static_cast<size_t>(image_size);
+}
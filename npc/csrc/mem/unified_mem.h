@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+class VerilatedSerialize;
+class VerilatedDeserialize;
+
+// Guest physical memory shared by the I$/D$ refill models.
+//
+// The PMEM window (matching PMEM_SIZE in abstract-machine riscv/npc/trm.c) is
+// one anonymous mmap, so the host only commits the pages the guest touches
+// and every access inside it is a bounds check plus a pointer add. Addresses
+// outside the window (e.g. MMIO lines the D$ allocates) fall back to lazily
+// allocated 4 KiB pages.
+//
+// PMEM pages written since the last clear() are marked in a bitmap, so
+// checkpoints and the difftest REF sync only touch those.
+struct UnifiedMem {
+  static constexpr uint32_t kPmemBase = 0x80000000u;
+  static constexpr uint32_t kPmemSize = 128u * 1024u * 1024u;
+  static constexpr uint32_t kPageBits = 12;
+  static constexpr uint32_t kPageSize = 1u << kPageBits;
+  static constexpr uint32_t kLineWords = 8;
+  static constexpr uint32_t kLineBytes = kLineWords * 4u;
+
+  using Line = std::array<uint32_t, kLineWords>;
+
+  UnifiedMem();
+  ~UnifiedMem();
+  UnifiedMem(const UnifiedMem &) = delete;
+  UnifiedMem &operator=(const UnifiedMem &) = delete;
+
+  static bool in_pmem(uint32_t addr) { return addr - kPmemBase < kPmemSize; }
+  // Word of its line that `addr` falls in.
+  static uint32_t line_word(uint32_t addr) { return (addr / 4) % kLineWords; }
+
+  uint32_t read_word(uint32_t addr) const {
+    addr &= ~0x3u;
+    const uint8_t *p = in_pmem(addr) ? pmem_ + (addr - kPmemBase)
+                                     : find_page(addr);
+    if (!p) return 0u;
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+  }
+
+  void write_word(uint32_t addr, uint32_t data) {
+    addr &= ~0x3u;
+    uint8_t *p;
+    if (in_pmem(addr)) {
+      mark_dirty(addr - kPmemBase);
+      p = pmem_ + (addr - kPmemBase);
+    } else {
+      p = page_for(addr);
+    }
+    std::memcpy(p, &data, sizeof(data));
+  }
+
+  void fill_line(uint32_t line_addr, Line &line) const {
+    read_bytes(line_addr & ~0x3u, line.data(), kLineBytes);
+  }
+
+  void write_line(uint32_t line_addr, const Line &line) {
+    write_bytes(line_addr & ~0x3u, line.data(), kLineBytes);
+  }
+
+  void read_bytes(uint32_t addr, void *dst, size_t n) const;
+  void write_bytes(uint32_t addr, const void *src, size_t n);
+
+  // Host pointer to `addr` inside the PMEM window, nullptr otherwise. For
+  // reading; writes must go through write_*() to be tracked.
+  const uint8_t *host_ptr(uint32_t addr) const {
+    return in_pmem(addr) ? pmem_ + (addr - kPmemBase) : nullptr;
+  }
+
+  // Calls fn(addr) for each dirty PMEM page, in address order.
+  template <typename F>
+  void for_each_dirty_page(F &&fn) const {
+    for (uint32_t w = 0; w < kDirtyWords; w++) {
+      for (uint64_t bits = dirty_[w]; bits; bits &= bits - 1) {
+        uint32_t page = w * 64 + static_cast<uint32_t>(__builtin_ctzll(bits));
+        fn(kPmemBase + (page << kPageBits));
+      }
+    }
+  }
+
+  bool load_binary(const std::string &path, uint32_t base);
+  // Drop all contents; the PMEM window reads as zero again.
+  void clear();
+
+  // Checkpointing stores the dirty PMEM pages and the pages outside it.
+  void save(VerilatedSerialize &os) const;
+  void restore(VerilatedDeserialize &is);
+  // Size of the last image loaded by load_binary().
+  size_t image_size() const { return image_size_; }
+
+ private:
+  using Page = std::array<uint8_t, kPageSize>;
+  static constexpr uint32_t kDirtyWords = kPmemSize / kPageSize / 64;
+
+  void mark_dirty(uint32_t off) {
+    dirty_[off >> (kPageBits + 6)] |= 1ull << ((off >> kPageBits) & 63);
+  }
+
+  const uint8_t *find_page(uint32_t addr) const;
+  uint8_t *page_for(uint32_t addr);
+
+  uint8_t *pmem_ = nullptr;
+  size_t image_size_ = 0;
+  std::unordered_map<uint32_t, std::unique_ptr<Page>> pages_;
+  std::array<uint64_t, kDirtyWords> dirty_{};
+};
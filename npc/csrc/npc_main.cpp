@@ -1,38 +1,85 @@
+#include <fcntl.h>
 #include <fmt/format.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "Vtb_triathlon.h"
+#include "checkpoint/checkpoint.h"
+#include "checkpoint/fork_snapshot.h"
+#include "debug/debugger.h"
+#include "difftest/difftest.h"
+#include "logger/json.h"
 #include "logger/logger.h"
+#include "logger/perf_series.h"
+#include "logger/sim_stats.h"
 #include "logger/snapshot.h"
+#include "mem/mem_system.h"
+#include "profile/branch_profile.h"
+#include "profile/func_profile.h"
+#include "profile/stall_profile.h"
+#include "trace/cache_trace.h"
+#include "trace/commit_log.h"
+#include "trace/pipe_trace.h"
+#include "trace/wave.h"
 #include "verilated.h"
-#include "verilated_vcd_c.h"
 
 namespace {
 
-constexpr uint32_t kPmemBase = 0x80000000u;
+constexpr uint32_t kPmemBase = UnifiedMem::kPmemBase;
 constexpr uint32_t kEbreakInsn = 0x00100073u;
-constexpr uint32_t kSerialPort = 0xA00003F8u;
 
 struct SimArgs {
   std::string img_path;
+  std::string difftest_so;
   uint64_t max_cycles = 2000000;
-  bool trace = false;
-  std::string trace_path = "npc.vcd";
+  WaveConfig wave;
   bool commit_trace = false;
+  std::string commit_log;
+  std::string cache_trace;
+  std::string pipe_trace;
+  uint64_t pipe_trace_start = 0;
+  uint64_t pipe_trace_end = UINT64_MAX;
   bool fe_trace = false;
   bool bru_trace = false;
   bool stall_trace = false;
   uint64_t stall_threshold = 200;
   uint64_t progress_interval = 0;
+  bool sim_stats = false;
+  uint64_t perf_interval = 100000;
+  std::string perf_out;
+  std::string elf_path;
+  std::string profile_folded;
+  uint64_t profile_top = 30;
+  bool branch_profile = false;
+  std::string branch_trace;
+  uint64_t branch_top = 10;
+  bool stall_profile = false;
+  uint64_t stall_top = 10;
+  uint64_t core_freq_mhz = 100;
+  std::string serial_in;
+  uint64_t save_checkpoint_at = 0;
+  uint64_t checkpoint_every = 0;
+  std::string checkpoint_prefix = "npc";
+  uint64_t fork_snapshot_every = 0;
+  uint64_t fork_snapshot_keep = 2;
+  std::string restore_path;
+  std::string result_path;
+  std::string batch_path;
+  bool interactive = false;
+  std::string mem_model = "fixed";
+  std::string l2_repl = "lru";
+  std::string l2_wb_alloc = "on";
+  std::vector<std::pair<std::string, uint64_t>> mem_overrides;
 };
 
 static bool parse_u64(const std::string& s, uint64_t& out) {
@@ -45,13 +92,31 @@ static bool parse_u64(const std::string& s, uint64_t& out) {
   }
 }
 
+// Matches "--name=V" and "--name V"; on a match `i` is advanced past V.
+static bool take_value(int argc, char** argv, int& i, const std::string& name,
+                       std::string& out) {
+  std::string arg = argv[i];
+  if (arg == name && i + 1 < argc) {
+    out = argv[++i];
+    return true;
+  }
+  if (arg.rfind(name + "=", 0) == 0) {
+    out = arg.substr(name.size() + 1);
+    return true;
+  }
+  return false;
+}
+
 static SimArgs parse_args(int argc, char** argv) {
   SimArgs args;
   for (int i = 1; i < argc; i++) {
     std::string arg = argv[i];
 
     if (arg == "-d") {
-      if (i + 1 < argc) i++;
+      if (i + 1 < argc) {
+        args.difftest_so = argv[i + 1];
+        i++;
+      }
       continue;
     }
     if (arg == "--max-cycles" && i + 1 < argc) {
@@ -70,16 +135,16 @@ static SimArgs parse_args(int argc, char** argv) {
       continue;
     }
     if (arg == "--trace") {
-      args.trace = true;
+      args.wave.enabled = true;
       if (i + 1 < argc && argv[i + 1][0] != '-') {
-        args.trace_path = argv[i + 1];
+        args.wave.path = argv[i + 1];
         i++;
       }
       continue;
     }
     if (arg.rfind("--trace=", 0) == 0) {
-      args.trace = true;
-      args.trace_path = arg.substr(std::string("--trace=").size());
+      args.wave.enabled = true;
+      args.wave.path = arg.substr(std::string("--trace=").size());
       continue;
     }
     if (arg == "--commit-trace") {
@@ -131,6 +196,160 @@ static SimArgs parse_args(int argc, char** argv) {
       }
       continue;
     }
+    std::string value;
+    bool wave_opt = true;
+    if (take_value(argc, argv, i, "--trace-start", value)) {
+      parse_u64(value, args.wave.start);
+    } else if (take_value(argc, argv, i, "--trace-end", value)) {
+      parse_u64(value, args.wave.end);
+    } else if (take_value(argc, argv, i, "--trace-pre", value)) {
+      parse_u64(value, args.wave.pre);
+    } else if (take_value(argc, argv, i, "--trace-post", value)) {
+      parse_u64(value, args.wave.post);
+    } else if (take_value(argc, argv, i, "--trace-trigger", value)) {
+      if (!args.wave.parse_trigger(value)) {
+        std::cerr << "Unknown --trace-trigger: " << value << "\n";
+      }
+    } else {
+      wave_opt = false;
+    }
+    if (wave_opt) {
+      args.wave.enabled = true;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--commit-log", value)) {
+      args.commit_log = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--perf-interval", value)) {
+      parse_u64(value, args.perf_interval);
+      continue;
+    }
+    if (take_value(argc, argv, i, "--perf-out", value)) {
+      args.perf_out = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--elf", value)) {
+      args.elf_path = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--profile-folded", value)) {
+      args.profile_folded = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--profile-top", value)) {
+      parse_u64(value, args.profile_top);
+      continue;
+    }
+    if (arg == "--sim-stats") {
+      args.sim_stats = true;
+      continue;
+    }
+    if (arg == "--interactive") {
+      args.interactive = true;
+      continue;
+    }
+    if (arg == "--branch-profile") {
+      args.branch_profile = true;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--branch-top", value)) {
+      parse_u64(value, args.branch_top);
+      continue;
+    }
+    if (take_value(argc, argv, i, "--branch-trace", value)) {
+      args.branch_trace = value;
+      continue;
+    }
+    if (arg == "--stall-profile") {
+      args.stall_profile = true;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--stall-top", value)) {
+      parse_u64(value, args.stall_top);
+      continue;
+    }
+    if (take_value(argc, argv, i, "--cache-trace", value)) {
+      args.cache_trace = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--pipe-trace-start", value)) {
+      parse_u64(value, args.pipe_trace_start);
+      continue;
+    }
+    if (take_value(argc, argv, i, "--pipe-trace-end", value)) {
+      parse_u64(value, args.pipe_trace_end);
+      continue;
+    }
+    if (take_value(argc, argv, i, "--pipe-trace", value)) {
+      args.pipe_trace = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--core-freq-mhz", value)) {
+      parse_u64(value, args.core_freq_mhz);
+      continue;
+    }
+    if (take_value(argc, argv, i, "--serial-in", value)) {
+      args.serial_in = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--save-checkpoint-at", value)) {
+      parse_u64(value, args.save_checkpoint_at);
+      continue;
+    }
+    if (take_value(argc, argv, i, "--checkpoint-every", value)) {
+      parse_u64(value, args.checkpoint_every);
+      continue;
+    }
+    if (take_value(argc, argv, i, "--fork-snapshot-every", value)) {
+      parse_u64(value, args.fork_snapshot_every);
+      continue;
+    }
+    if (take_value(argc, argv, i, "--fork-snapshot-keep", value)) {
+      parse_u64(value, args.fork_snapshot_keep);
+      continue;
+    }
+    if (take_value(argc, argv, i, "--checkpoint-prefix", value)) {
+      args.checkpoint_prefix = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--restore", value)) {
+      args.restore_path = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--result", value)) {
+      args.result_path = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--batch", value)) {
+      args.batch_path = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--mem-model", value)) {
+      args.mem_model = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--l2-repl", value)) {
+      args.l2_repl = value;
+      continue;
+    }
+    if (take_value(argc, argv, i, "--l2-wb-alloc", value)) {
+      args.l2_wb_alloc = value;
+      continue;
+    }
+    bool mem_opt = false;
+    for (const char* name :
+         {"--mem-latency", "--mem-row-hit", "--mem-row-miss", "--mem-banks",
+          "--mem-row-bytes", "--mem-bw", "--l2-size", "--l2-ways",
+          "--l2-latency", "--axi-read-latency",
+          "--axi-write-latency", "--axi-beat-cycles", "--axi-outstanding"}) {
+      if (!take_value(argc, argv, i, name, value)) continue;
+      uint64_t v = 0;
+      if (parse_u64(value, v)) args.mem_overrides.emplace_back(name, v);
+      mem_opt = true;
+      break;
+    }
+    if (mem_opt) continue;
     if (!arg.empty() && arg[0] == '-') {
       continue;
     }
@@ -139,219 +358,252 @@ static SimArgs parse_args(int argc, char** argv) {
   return args;
 }
 
-struct UnifiedMem {
-  std::unordered_map<uint32_t, uint32_t> words;
-
-  void write_word(uint32_t addr, uint32_t data) { words[addr & ~0x3u] = data; }
-
-  uint32_t read_word(uint32_t addr) const {
-    auto it = words.find(addr & ~0x3u);
-    if (it == words.end()) return 0u;
-    return it->second;
+static bool build_mem_timing(const SimArgs& args, MemTimingConfig& cfg) {
+  MemTimingConfig::Kind kind;
+  if (!MemTimingConfig::parse_kind(args.mem_model, kind)) {
+    std::cerr << "Unknown --mem-model: " << args.mem_model << "\n";
+    return false;
   }
-
-  void fill_line(uint32_t line_addr, std::array<uint32_t, 8>& line) const {
-    for (int i = 0; i < 8; i++) {
-      line[i] = read_word(line_addr + 4u * static_cast<uint32_t>(i));
-    }
+  cfg = MemTimingConfig::preset(kind);
+  for (const auto& [name, v] : args.mem_overrides) {
+    uint32_t v32 = static_cast<uint32_t>(v);
+    if (name == "--mem-latency") cfg.latency = v32;
+    if (name == "--mem-row-hit") cfg.row_hit_latency = v32;
+    if (name == "--mem-row-miss") cfg.row_miss_latency = v32;
+    if (name == "--mem-banks") cfg.num_banks = v32;
+    if (name == "--mem-row-bytes") cfg.row_bytes = v32;
+    if (name == "--mem-bw") cfg.bytes_per_cycle = v32;
   }
+  return true;
+}
 
-  void write_line(uint32_t line_addr, const std::array<uint32_t, 8>& line) {
-    for (int i = 0; i < 8; i++) {
-      write_word(line_addr + 4u * static_cast<uint32_t>(i), line[i]);
-    }
+static bool build_l2_config(const SimArgs& args, L2Config& cfg) {
+  if (!L2Config::parse_repl(args.l2_repl, cfg.repl)) {
+    std::cerr << "Unknown --l2-repl: " << args.l2_repl << "\n";
+    return false;
   }
-
-  bool load_binary(const std::string& path, uint32_t base) {
-    std::ifstream ifs(path, std::ios::binary);
-    if (!ifs) {
-      std::cerr << "Failed to open IMG: " << path << "\n";
-      return false;
-    }
-    std::vector<uint8_t> buf((std::istreambuf_iterator<char>(ifs)),
-                             std::istreambuf_iterator<char>());
-    for (size_t i = 0; i < buf.size(); i += 4) {
-      uint32_t word = 0;
-      for (size_t b = 0; b < 4; b++) {
-        if (i + b < buf.size()) {
-          word |= static_cast<uint32_t>(buf[i + b]) << (8 * b);
-        }
-      }
-      write_word(base + static_cast<uint32_t>(i), word);
-    }
-    return true;
+  if (args.l2_wb_alloc != "on" && args.l2_wb_alloc != "off") {
+    std::cerr << "Unknown --l2-wb-alloc: " << args.l2_wb_alloc << "\n";
+    return false;
   }
-};
-
-struct ICacheModel {
-  bool pending = false;
-  int delay = 0;
-  uint32_t miss_addr = 0;
-  uint32_t miss_way = 0;
-  bool refill_pulse = false;
-  std::array<uint32_t, 8> line_words{};
-  UnifiedMem* mem = nullptr;
-
-  void reset() {
-    pending = false;
-    delay = 0;
-    miss_addr = 0;
-    miss_way = 0;
-    refill_pulse = false;
-  }
-
-  void drive(Vtb_triathlon* top) {
-    top->icache_miss_req_ready_i = 1;
-    if (refill_pulse) {
-      top->icache_refill_valid_i = 1;
-      top->icache_refill_paddr_i = miss_addr;
-      top->icache_refill_way_i = miss_way;
-      for (int i = 0; i < 8; i++) top->icache_refill_data_i[i] = line_words[i];
-    } else {
-      top->icache_refill_valid_i = 0;
-      top->icache_refill_paddr_i = 0;
-      top->icache_refill_way_i = 0;
-      for (int i = 0; i < 8; i++) top->icache_refill_data_i[i] = 0;
-    }
+  cfg.wb_allocate = args.l2_wb_alloc == "on";
+  for (const auto& [name, v] : args.mem_overrides) {
+    uint32_t v32 = static_cast<uint32_t>(v);
+    if (name == "--l2-size") cfg.size_bytes = v32;
+    if (name == "--l2-ways") cfg.ways = v32;
+    if (name == "--l2-latency") cfg.latency = v32;
   }
-
-  void observe(Vtb_triathlon* top) {
-    if (!top->rst_ni) {
-      reset();
-      return;
-    }
-
-    if (refill_pulse) {
-      refill_pulse = false;
-    }
-
-    if (!pending && top->icache_miss_req_valid_o) {
-      pending = true;
-      delay = 2;
-      miss_addr = top->icache_miss_req_paddr_o;
-      miss_way = top->icache_miss_req_victim_way_o;
-      if (mem) mem->fill_line(miss_addr, line_words);
-    }
-
-    if (pending) {
-      if (delay > 0) {
-        delay--;
-      } else if (top->icache_refill_ready_o) {
-        refill_pulse = true;
-        pending = false;
-      }
-    }
+  if (cfg.size_bytes % (UnifiedMem::kLineBytes * std::max(cfg.ways, 1u))) {
+    std::cerr << "--l2-size must be a multiple of " << UnifiedMem::kLineBytes
+              << " x --l2-ways bytes\n";
+    return false;
   }
-};
+  return true;
+}
 
-struct DCacheModel {
-  bool pending = false;
-  int delay = 0;
-  uint32_t miss_addr = 0;
-  uint32_t miss_way = 0;
-  bool refill_pulse = false;
-  std::array<uint32_t, 8> line_words{};
-  UnifiedMem* mem = nullptr;
-
-  void reset() {
-    pending = false;
-    delay = 0;
-    miss_addr = 0;
-    miss_way = 0;
-    refill_pulse = false;
-  }
-
-  void drive(Vtb_triathlon* top) {
-    top->dcache_miss_req_ready_i = 1;
-    top->dcache_wb_req_ready_i = 1;
-    if (refill_pulse) {
-      top->dcache_refill_valid_i = 1;
-      top->dcache_refill_paddr_i = miss_addr;
-      top->dcache_refill_way_i = miss_way;
-      for (int i = 0; i < 8; i++) top->dcache_refill_data_i[i] = line_words[i];
-    } else {
-      top->dcache_refill_valid_i = 0;
-      top->dcache_refill_paddr_i = 0;
-      top->dcache_refill_way_i = 0;
-      for (int i = 0; i < 8; i++) top->dcache_refill_data_i[i] = 0;
-    }
+// --axi-* options need a MEM_IF=axi build; the refill ports have no bus.
+static bool build_axi_config(const SimArgs& args, AxiSlaveConfig& cfg) {
+  for (const auto& [name, v] : args.mem_overrides) {
+    if (name.rfind("--axi-", 0) != 0) continue;
+#ifndef NPC_AXI
+    std::cerr << name << " needs a MEM_IF=axi build\n";
+    return false;
+#endif
+    uint32_t v32 = static_cast<uint32_t>(v);
+    if (name == "--axi-read-latency") cfg.read_latency = v32;
+    if (name == "--axi-write-latency") cfg.write_latency = v32;
+    if (name == "--axi-beat-cycles") cfg.beat_cycles = v32;
+    if (name == "--axi-outstanding") cfg.outstanding = v32;
   }
+  return true;
+}
 
-  void observe(Vtb_triathlon* top) {
-    if (!top->rst_ni) {
-      reset();
-      return;
-    }
-
-    if (refill_pulse) {
-      refill_pulse = false;
-    }
+static void fill_mem_perf(const MemSystem& mem, Snapshot& snap) {
+  const MemTimingStats& st = mem.timing.stats();
+  snap.mem_model = mem.timing.config().kind_name();
+  snap.mem_bytes_per_cycle = mem.timing.config().bytes_per_cycle;
+  snap.mem_read_reqs = st.read_reqs;
+  snap.mem_write_reqs = st.write_reqs;
+  snap.mem_read_bytes = st.read_bytes;
+  snap.mem_write_bytes = st.write_bytes;
+  snap.mem_read_latency_sum = st.read_latency_sum;
+  snap.mem_bus_busy_cycles = st.bus_busy_cycles;
+  snap.mem_row_hits = st.row_hits;
+  snap.mem_row_misses = st.row_misses;
+  const L2Stats& l2 = mem.l2.stats();
+  snap.l2_size_bytes = mem.l2.enabled() ? mem.l2.config().size_bytes : 0;
+  snap.l2_ihits = l2.hits[L2Cache::kICache];
+  snap.l2_imisses = l2.misses[L2Cache::kICache];
+  snap.l2_dhits = l2.hits[L2Cache::kDCache];
+  snap.l2_dmisses = l2.misses[L2Cache::kDCache];
+  snap.l2_wb_hits = l2.wb_hits;
+  snap.l2_wb_misses = l2.wb_misses;
+  snap.l2_evictions = l2.evictions;
+  snap.l2_dirty_evictions = l2.dirty_evictions;
+#ifdef NPC_AXI
+  const AxiSlaveStats& axi = mem.axi.stats();
+  snap.axi_reads = axi.reads;
+  snap.axi_writes = axi.writes;
+  snap.axi_r_beats = axi.r_beats;
+  snap.axi_read_latency_sum = axi.read_latency_sum;
+  snap.axi_r_conflict_cycles = axi.r_conflict_cycles;
+#endif
+}
 
-    if (!pending && top->dcache_miss_req_valid_o) {
-      pending = true;
-      delay = 2;
-      miss_addr = top->dcache_miss_req_paddr_o;
-      miss_way = top->dcache_miss_req_victim_way_o;
-      if (mem) mem->fill_line(miss_addr, line_words);
-    }
+// Run summary as a flat JSON object: one key per line for tools/regress.cpp
+// (--result), or a single line per image in --batch mode.
+static std::string format_result(const char* status, int code,
+                                 const std::string& img, const Snapshot& snap,
+                                 const SimStats& stats, bool one_line) {
+  const char* sep = one_line ? ", " : ",\n  ";
+  double ipc = snap.cycles ? static_cast<double>(snap.total_commits) /
+                                 static_cast<double>(snap.cycles)
+                           : 0.0;
+  std::string out = one_line ? "{" : "{\n  ";
+  out += fmt::format("\"status\": \"{}\"", status);
+  out += fmt::format("{}\"exit_code\": {}", sep, code);
+  out += fmt::format("{}\"image\": {}", sep, json_string(img));
+  out += fmt::format("{}\"cycles\": {}", sep, snap.cycles);
+  out += fmt::format("{}\"instrs\": {}", sep, snap.total_commits);
+  out += fmt::format("{}\"ipc\": {:.6f}", sep, ipc);
+  out += fmt::format("{}\"mem_model\": \"{}\"", sep, snap.mem_model);
+  if (stats.enabled()) {
+    out += fmt::format("{}\"host_seconds\": {:.3f}", sep, stats.seconds());
+    out += fmt::format("{}\"host_khz\": {:.1f}", sep, stats.khz(snap.cycles));
+  }
+  for_each_counter(snap, [&](const char* name, uint64_t value) {
+    out += fmt::format("{}\"{}\": {}", sep, name, value);
+  });
+  out += one_line ? "}\n" : "\n}\n";
+  return out;
+}
 
-    if (pending) {
-      if (delay > 0) {
-        delay--;
-      } else if (top->dcache_refill_ready_o) {
-        refill_pulse = true;
-        pending = false;
-      }
-    }
+static void write_result(const std::string& path, const std::string& json) {
+  std::ofstream out(path);
+  if (!out) {
+    std::cerr << "Failed to write result: " << path << "\n";
+    return;
+  }
+  out << json;
+}
 
-    if (top->dcache_wb_req_valid_o && top->dcache_wb_req_ready_i) {
-      std::array<uint32_t, 8> wb_line{};
-      for (int i = 0; i < 8; i++) wb_line[i] = top->dcache_wb_req_data_o[i];
-      if (mem) mem->write_line(top->dcache_wb_req_paddr_o, wb_line);
-    }
+// Image paths from a --batch list, one per line; blank lines and lines
+// starting with '#' are skipped.
+static bool read_batch_list(const std::string& path,
+                            std::vector<std::string>& images) {
+  std::ifstream in(path);
+  if (!in) {
+    std::cerr << "Failed to open batch list: " << path << "\n";
+    return false;
   }
-};
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t b = line.find_first_not_of(" \t\r");
+    if (b == std::string::npos || line[b] == '#') continue;
+    size_t e = line.find_last_not_of(" \t\r");
+    images.push_back(line.substr(b, e - b + 1));
+  }
+  if (images.empty()) {
+    std::cerr << "Empty batch list: " << path << "\n";
+    return false;
+  }
+  return true;
+}
 
-struct MemSystem {
-  UnifiedMem mem;
-  ICacheModel icache;
-  DCacheModel dcache;
+// Snapshots replay into the same process image, so file outputs that are
+// written as the run goes would be written twice.
+static bool check_fork_snapshot_args(const SimArgs& args) {
+  if (args.wave.enabled || !args.commit_log.empty() ||
+      !args.cache_trace.empty() || !args.pipe_trace.empty() ||
+      !args.perf_out.empty() || !args.branch_trace.empty() ||
+      !args.batch_path.empty() || args.interactive) {
+    std::cerr << "--fork-snapshot-every cannot be combined with --batch,"
+              << " --interactive, --trace or streamed traces; the replay"
+              << " writes its own wave\n";
+    return false;
+  }
+  return true;
+}
 
-  void reset() {
-    icache.reset();
-    dcache.reset();
+// The pre-trigger window is replayed by a forked snapshot, which would
+// write streamed outputs a second time.
+static bool check_wave_trigger_args(const SimArgs& args) {
+  if (!args.commit_log.empty() || !args.cache_trace.empty() ||
+      !args.pipe_trace.empty() || !args.perf_out.empty() ||
+      !args.branch_trace.empty() || args.fork_snapshot_every ||
+      args.interactive) {
+    std::cerr << "--trace-trigger with --trace-pre cannot be combined with"
+              << " --fork-snapshot-every, --interactive or streamed traces;"
+              << " use --trace-pre 0\n";
+    return false;
   }
+  return true;
+}
 
-  void drive(Vtb_triathlon* top) {
-    icache.drive(top);
-    dcache.drive(top);
+// Options that produce one artifact per run and have no per-image meaning.
+static bool check_batch_args(const SimArgs& args) {
+  if (args.wave.enabled || !args.commit_log.empty() ||
+      !args.cache_trace.empty() || !args.pipe_trace.empty() ||
+      !args.perf_out.empty() || !args.elf_path.empty() ||
+      args.branch_profile || !args.branch_trace.empty() || args.stall_profile ||
+      args.save_checkpoint_at || args.checkpoint_every ||
+      !args.restore_path.empty() || !args.img_path.empty() ||
+      args.interactive) {
+    std::cerr << "--batch runs the images in its list and cannot be combined"
+              << " with an image, --restore, --interactive, --trace,"
+              << " checkpoints, traces or profiles\n";
+    return false;
   }
+  return true;
+}
 
-  void observe(Vtb_triathlon* top) {
-    icache.observe(top);
-    dcache.observe(top);
+// Demand accesses accepted by the caches this cycle.
+static void trace_cache_accesses(const Vtb_triathlon* top,
+                                 CacheTraceWriter& out) {
+  if (top->dbg_ifu_req_valid_o && top->dbg_ifu_req_ready_o) {
+    out.append(top->dbg_ifu_req_addr_o, CacheAccess::kFetch);
   }
-};
+  uint32_t ld_addr = top->dbg_lsu_ld_req_addr_o;
+  if (top->dbg_lsu_ld_req_valid_o && top->dbg_lsu_ld_req_ready_o &&
+      !DeviceBus::in_mmio(ld_addr)) {
+    out.append(ld_addr, CacheAccess::kLoad);
+  }
+  uint32_t st_addr = top->dbg_sb_dcache_req_addr_o;
+  if (top->dbg_sb_dcache_req_valid_o && top->dbg_sb_dcache_req_ready_o &&
+      !DeviceBus::in_mmio(st_addr)) {
+    out.append(st_addr, CacheAccess::kStore);
+  }
+}
 
-static void tick(Vtb_triathlon* top, MemSystem& mem, VerilatedVcdC* tfp,
-                 vluint64_t& sim_time) {
-  mem.drive(top);
+static void tick(Vtb_triathlon* top, MemSystem& mem, WaveTracer& wave,
+                 vluint64_t& sim_time, SimStats& stats) {
+  {
+    SimStats::Scope t(stats, SimStats::kMem);
+    mem.drive(top);
+  }
   top->clk_i = 0;
-  top->eval();
-  if (tfp) tfp->dump(sim_time++);
+  {
+    SimStats::Scope t(stats, SimStats::kEval);
+    top->eval();
+  }
+  wave.dump(sim_time++);
   top->clk_i = 1;
-  top->eval();
-  if (tfp) tfp->dump(sim_time++);
+  {
+    SimStats::Scope t(stats, SimStats::kEval);
+    top->eval();
+  }
+  wave.dump(sim_time++);
+  SimStats::Scope t(stats, SimStats::kMem);
   mem.observe(top);
 }
 
-static void reset(Vtb_triathlon* top, MemSystem& mem, VerilatedVcdC* tfp,
-                  vluint64_t& sim_time) {
+static void reset(Vtb_triathlon* top, MemSystem& mem, WaveTracer& wave,
+                  vluint64_t& sim_time, SimStats& stats) {
   top->rst_ni = 0;
   mem.reset();
-  for (int i = 0; i < 5; i++) tick(top, mem, tfp, sim_time);
+  for (int i = 0; i < 5; i++) tick(top, mem, wave, sim_time, stats);
   top->rst_ni = 1;
-  for (int i = 0; i < 2; i++) tick(top, mem, tfp, sim_time);
+  for (int i = 0; i < 2; i++) tick(top, mem, wave, sim_time, stats);
 }
 
 }  // namespace
@@ -360,11 +612,47 @@ int main(int argc, char** argv) {
   Verilated::commandArgs(argc, argv);
   SimArgs args = parse_args(argc, argv);
 
-  if (args.img_path.empty()) {
+  if (!args.batch_path.empty() && !check_batch_args(args)) return 1;
+  if (args.fork_snapshot_every && !check_fork_snapshot_args(args)) return 1;
+  if (args.wave.enabled && args.wave.trigger != WaveConfig::Trigger::kNone &&
+      args.wave.pre && !check_wave_trigger_args(args)) {
+    return 1;
+  }
+  if (args.img_path.empty() && args.restore_path.empty() &&
+      args.batch_path.empty()) {
     std::cerr << "Usage: " << argv[0]
-              << " <IMG> [--max-cycles N] [--trace [vcd]] [--commit-trace]"
+              << " <IMG> [--max-cycles N] [--trace [FILE]] [--trace-start N]"
+              << " [--trace-end N] [--trace-trigger flush|stall|pc=ADDR]"
+              << " [--trace-pre N] [--trace-post N] [--commit-trace]"
+              << " [--commit-log FILE[.zst|.lz4]] [--cache-trace FILE]"
+              << " [--pipe-trace FILE] [--pipe-trace-start N]"
+              << " [--pipe-trace-end N]"
               << " [--bru-trace] [--fe-trace] [--stall-trace [N]]"
-              << " [--progress [N]]\n";
+              << " [--progress [N]] [--sim-stats]"
+              << " [--perf-interval N] [--perf-out FILE]"
+              << " [--elf FILE] [--profile-folded FILE] [--profile-top N]"
+              << " [--branch-profile] [--branch-top N] [--branch-trace FILE]"
+              << " [--stall-profile] [--stall-top N]"
+              << " [-d REF_SO]"
+              << " [--mem-model fixed|ddr] [--mem-latency N] [--mem-bw B]"
+              << " [--mem-row-hit N] [--mem-row-miss N] [--mem-banks N]"
+              << " [--mem-row-bytes N] [--l2-size BYTES] [--l2-ways N]"
+              << " [--l2-latency N] [--l2-repl lru|fifo|random]"
+              << " [--l2-wb-alloc on|off] [--axi-read-latency N]"
+              << " [--axi-write-latency N] [--axi-beat-cycles N]"
+              << " [--axi-outstanding N] [--core-freq-mhz N]"
+              << " [--serial-in FILE] [--save-checkpoint-at N]"
+              << " [--checkpoint-every N] [--checkpoint-prefix P]"
+              << " [--fork-snapshot-every N] [--fork-snapshot-keep K]"
+              << " [--restore FILE] [--result FILE] [--interactive]\n"
+              << "       " << argv[0] << " --batch LIST [--result FILE]"
+              << " [--max-cycles N] [-d REF_SO] [--mem-model ...]\n";
+    return 1;
+  }
+
+  std::vector<std::string> batch_images;
+  if (!args.batch_path.empty() &&
+      !read_batch_list(args.batch_path, batch_images)) {
     return 1;
   }
 
@@ -377,124 +665,420 @@ int main(int argc, char** argv) {
   log_config.progress_interval = args.progress_interval;
   Logger::init(log_config);
 
+  MemTimingConfig mem_timing;
+  if (!build_mem_timing(args, mem_timing)) return 1;
+  L2Config l2_config;
+  if (!build_l2_config(args, l2_config)) return 1;
+  AxiSlaveConfig axi_config;
+  if (!build_axi_config(args, axi_config)) return 1;
+
   MemSystem mem;
-  if (!mem.mem.load_binary(args.img_path, kPmemBase)) return 1;
-  mem.icache.mem = &mem.mem;
-  mem.dcache.mem = &mem.mem;
+  mem.configure(mem_timing);
+  mem.configure_l2(l2_config);
+  mem.configure_axi(axi_config);
+  if (!args.img_path.empty() &&
+      !mem.mem.load_binary(args.img_path, kPmemBase)) {
+    return 1;
+  }
 
-  auto* top = new Vtb_triathlon;
-  VerilatedVcdC* tfp = nullptr;
-  vluint64_t sim_time = 0;
+  SerialDevice serial;
+  if (!args.serial_in.empty() && !serial.load_input(args.serial_in)) return 1;
+  serial.attach(mem.devices);
+  RtcDevice rtc(&mem.now, static_cast<uint32_t>(args.core_freq_mhz));
+  rtc.attach(mem.devices);
+
+  Difftest difftest;
+  if (!args.difftest_so.empty() && args.batch_path.empty() &&
+      !difftest.init(args.difftest_so, mem.mem, kPmemBase)) {
+    return 1;
+  }
+
+  CommitLogWriter commit_log;
+  if (!args.commit_log.empty() && !commit_log.open(args.commit_log)) return 1;
+
+  CacheTraceWriter cache_trace;
+  if (!args.cache_trace.empty() && !cache_trace.open(args.cache_trace)) {
+    return 1;
+  }
+
+  PipeTrace pipe_trace;
+  if (!args.pipe_trace.empty() &&
+      !pipe_trace.open(args.pipe_trace, args.pipe_trace_start,
+                       args.pipe_trace_end)) {
+    return 1;
+  }
+
+  PerfSeries perf_series;
+  uint64_t perf_interval = std::max<uint64_t>(args.perf_interval, 1);
+  if (!args.perf_out.empty() &&
+      !perf_series.open(args.perf_out, perf_interval)) {
+    return 1;
+  }
+
+  FuncProfiler profiler;
+  if (!args.elf_path.empty() && !profiler.open(args.elf_path)) return 1;
+
+  BranchProfiler branch_prof;
+  if (args.branch_profile) branch_prof.enable();
+  if (!args.branch_trace.empty() &&
+      !branch_prof.open_trace(args.branch_trace)) {
+    return 1;
+  }
+
+  StallProfiler stall_prof;
+  if (args.stall_profile) stall_prof.enable();
+
+  SimStats sim_stats;
+  if (args.sim_stats) sim_stats.enable();
+
+  Occupancy occupancy;
 
-  if (args.trace) {
+  ForkSnapshots fork_snaps;
+  if (args.fork_snapshot_every &&
+      !fork_snaps.configure(args.fork_snapshot_every,
+                            args.fork_snapshot_keep)) {
+    return 1;
+  }
+  Debugger debugger;
+  if (args.interactive) debugger.enable();
+
+  // A resumed snapshot, or the debugger's `wave on`, opens its wave mid-run.
+  if (fork_snaps.enabled() || debugger.enabled() || args.wave.enabled) {
     Verilated::traceEverOn(true);
-    tfp = new VerilatedVcdC;
-    top->trace(tfp, 99);
-    tfp->open(args.trace_path.c_str());
-  }
-
-  reset(top, mem, tfp, sim_time);
-
-  std::array<uint32_t, 32> rf{};
-  uint64_t no_commit_cycles = 0;
-  uint64_t total_commits = 0;
-  uint32_t last_commit_pc = 0;
-  uint32_t last_commit_inst = 0;
-  for (uint64_t cycles = 0; cycles < args.max_cycles; cycles++) {
-    tick(top, mem, tfp, sim_time);
-
-    if (top->dbg_sb_dcache_req_valid_o && top->dbg_sb_dcache_req_ready_o) {
-      uint32_t addr = top->dbg_sb_dcache_req_addr_o;
-      if (addr == kSerialPort) {
-        uint8_t ch =
-            static_cast<uint8_t>(top->dbg_sb_dcache_req_data_o & 0xFFu);
-        std::cout << static_cast<char>(ch) << std::flush;
-      }
-    }
+  }
 
-    bool need_flush_bru_log = top->backend_flush_o || top->dbg_bru_mispred_o;
-    bool need_periodic_log = Logger::needs_periodic_snapshot();
-    bool need_fe_mismatch_log =
-        Logger::config().fe_trace && top->dbg_fe_valid_o && top->dbg_fe_ready_o;
+  auto* top = new Vtb_triathlon;
+  SnapshotView snap_view(top, sim_stats);
+  WaveTracer wave;
+  SimState st;
+  vluint64_t& sim_time = st.sim_time;
 
-    bool any_commit = false;
-    for (int i = 0; i < 4; i++) {
-      bool valid = (top->commit_valid_o >> i) & 0x1;
-      if (!valid) continue;
-      any_commit = true;
-      total_commits++;
+  if (args.wave.enabled && !wave.open(top, args.wave)) {
+    delete top;
+    return 1;
+  }
+
+  // --batch writes one JSON line per image to --result.
+  std::ofstream batch_result;
+  if (!args.batch_path.empty() && !args.result_path.empty()) {
+    batch_result.open(args.result_path);
+    if (!batch_result) {
+      std::cerr << "Failed to write result: " << args.result_path << "\n";
+      delete top;
+      return 1;
+    }
+  }
 
-      bool we = (top->commit_we_o >> i) & 0x1;
-      uint32_t rd = (top->commit_areg_o >> (i * 5)) & 0x1F;
-      uint32_t data = top->commit_wdata_o[i];
-      if (we && rd != 0) {
-        rf[rd] = data;
+  // Per-image reporting, however the run ends.
+  auto end_run = [&](int code, const char* status) {
+    if (wave.replaying()) {
+      // Pre-trigger snapshot: the parent reports the run.
+      wave.close();
+      std::_Exit(0);
+    }
+    serial.flush();
+    if (!args.result_path.empty()) {
+      Snapshot snap = collect_snapshot(
+          top, st.cycles, st.total_commits, st.no_commit_cycles,
+          st.last_commit_pc, st.last_commit_inst, st.rf[10]);
+      fill_mem_perf(mem, snap);
+      std::string json = format_result(status, code, args.img_path, snap,
+                                       sim_stats, batch_result.is_open());
+      if (batch_result.is_open()) {
+        batch_result << json << std::flush;
+      } else {
+        write_result(args.result_path, json);
       }
+    }
+    if (!args.batch_path.empty()) {
+      double ipc = st.cycles ? static_cast<double>(st.total_commits) /
+                                   static_cast<double>(st.cycles)
+                             : 0.0;
+      Logger::log_info(fmt::format("[batch ] {} {} cycles={} ipc={:.4f}",
+                                   args.img_path, status, st.cycles, ipc));
+    }
+    sim_stats.report(st.cycles);
+    if (code != 0 && fork_snaps.enabled()) fork_snaps.replay(st.cycles);
+    return code;
+  };
 
-      uint32_t pc = top->commit_pc_o[i];
-      uint32_t inst = mem.mem.read_word(pc);
-      last_commit_pc = pc;
-      last_commit_inst = inst;
-      Logger::log_commit(cycles, i, pc, inst, we, rd, data, rf[10]);
-      if (inst == kEbreakInsn) {
-        uint32_t code = rf[10];
-        if (code == 0) {
-          Logger::log_info("HIT GOOD TRAP");
-          Snapshot snap =
-              collect_snapshot(top, cycles, total_commits, no_commit_cycles,
-                               last_commit_pc, last_commit_inst, rf[10]);
-          double ipc = cycles ? static_cast<double>(total_commits) /
-                                    static_cast<double>(cycles)
-                              : 0.0;
-          double cpi = total_commits ? static_cast<double>(cycles) /
-                                           static_cast<double>(total_commits)
-                                     : 0.0;
-          Logger::log_perf(snap, ipc, cpi);
-          if (tfp) tfp->close();
-          delete top;
-          Logger::shutdown();
-          return 0;
-        }
-        Logger::log_warn(fmt::format("HIT BAD TRAP (code={})", code));
-        if (tfp) tfp->close();
-        delete top;
-        Logger::shutdown();
-        return 1;
+  auto finish = [&](int code) {
+    fork_snaps.discard_all();
+    perf_series.sample(top, st.cycles);
+    perf_series.close();
+    if (profiler.enabled()) {
+      profiler.report(args.profile_top);
+      if (!args.profile_folded.empty()) {
+        profiler.write_folded(args.profile_folded);
       }
     }
+    if (branch_prof.enabled()) {
+      branch_prof.report(args.branch_top,
+                         profiler.enabled() ? &profiler.symbols() : nullptr);
+      branch_prof.close();
+    }
+    if (stall_prof.enabled()) {
+      stall_prof.report(args.stall_top,
+                        profiler.enabled() ? &profiler.symbols() : nullptr);
+    }
+    commit_log.close();
+    cache_trace.close();
+    pipe_trace.close();
+    wave.close();
+    delete top;
+    Logger::shutdown();
+    return code;
+  };
 
-    if (any_commit) {
-      no_commit_cycles = 0;
+  CheckpointTargets ckpt{top, &mem, &serial, &rtc, &difftest};
+  auto run = [&]() -> int {
+    if (!args.restore_path.empty()) {
+      if (!restore_checkpoint(args.restore_path, ckpt, st)) {
+        return end_run(1, "error");
+      }
     } else {
-      no_commit_cycles++;
+      reset(top, mem, wave, sim_time, sim_stats);
     }
+    if (perf_series.is_open()) perf_series.start(top, st.cycles);
+    if (stall_prof.enabled()) stall_prof.start(top);
+    if (profiler.enabled()) profiler.start(top);
+    sim_stats.start(st.cycles);
+    Debugger::Context dbg_ctx{top, &st, &mem.mem, &wave};
+    if (debugger.enabled() && !debugger.prompt(dbg_ctx)) {
+      return end_run(1, "quit");
+    }
+
+    auto& rf = st.rf;
+    uint64_t& no_commit_cycles = st.no_commit_cycles;
+    uint64_t& total_commits = st.total_commits;
+    uint32_t& last_commit_pc = st.last_commit_pc;
+    uint32_t& last_commit_inst = st.last_commit_inst;
+    for (uint64_t cycles = st.cycles; cycles < args.max_cycles; cycles++) {
+      wave.begin_cycle(cycles);
+      tick(top, mem, wave, sim_time, sim_stats);
+      if (cache_trace.is_open()) trace_cache_accesses(top, cache_trace);
+      if (pipe_trace.is_open()) pipe_trace.cycle(top, cycles);
+      occupancy.sample(top);
+
+      bool need_flush_bru_log =
+          (Logger::config().commit_trace || Logger::config().bru_trace) &&
+          (top->backend_flush_o || top->dbg_bru_mispred_o);
+      bool need_periodic_log = Logger::needs_periodic_snapshot();
+      bool need_fe_mismatch_log = Logger::config().fe_trace &&
+                                  top->dbg_fe_valid_o && top->dbg_fe_ready_o;
 
-    if (need_flush_bru_log || need_periodic_log || need_fe_mismatch_log) {
-      Snapshot snap =
-          collect_snapshot(top, cycles, total_commits, no_commit_cycles,
-                           last_commit_pc, last_commit_inst, rf[10]);
+      bool any_commit = false;
+      bool trigger_pc_hit = false;
+      for (int i = 0; i < 4; i++) {
+        bool valid = (top->commit_valid_o >> i) & 0x1;
+        if (!valid) continue;
+        any_commit = true;
+        total_commits++;
+
+        bool we = (top->commit_we_o >> i) & 0x1;
+        uint32_t rd = (top->commit_areg_o >> (i * 5)) & 0x1F;
+        uint32_t data = top->commit_wdata_o[i];
+        uint32_t pc = top->commit_pc_o[i];
+        uint32_t inst = mem.mem.read_word(pc);
+        if (difftest.enabled() && inst != kEbreakInsn &&
+            !difftest.commit(cycles, pc, inst, we, rd, data, rf)) {
+          Logger::log_warn(
+              fmt::format("DIFFTEST MISMATCH at cycle {}", cycles));
+          return end_run(1, "difftest_mismatch");
+        }
+        if (we && rd != 0) {
+          rf[rd] = data;
+        }
+
+        last_commit_pc = pc;
+        if (pc == args.wave.trigger_pc) trigger_pc_hit = true;
+        if (debugger.enabled()) debugger.commit(pc);
+        last_commit_inst = inst;
+        {
+          SimStats::Scope t(sim_stats, SimStats::kLog);
+          Logger::log_commit(cycles, i, pc, inst, we, rd, data, rf[10]);
+          if (commit_log.is_open()) {
+            commit_log.append(cycles, i, pc, inst, we, rd, data);
+          }
+        }
+        if (profiler.enabled()) profiler.retire(pc, inst);
+        if (branch_prof.enabled()) branch_prof.retire(pc, inst);
+        if (inst == kEbreakInsn) {
+          serial.flush();
+          if (difftest.enabled() && !difftest.check_group(cycles, rf)) {
+            Logger::log_warn(
+                fmt::format("DIFFTEST MISMATCH at cycle {}", cycles));
+            return end_run(1, "difftest_mismatch");
+          }
+          uint32_t code = rf[10];
+          if (code == 0) {
+            Logger::log_info("HIT GOOD TRAP");
+            Snapshot snap =
+                collect_snapshot(top, cycles, total_commits, no_commit_cycles,
+                                 last_commit_pc, last_commit_inst, rf[10]);
+            fill_mem_perf(mem, snap);
+            double ipc = cycles ? static_cast<double>(total_commits) /
+                                      static_cast<double>(cycles)
+                                : 0.0;
+            double cpi = total_commits ? static_cast<double>(cycles) /
+                                             static_cast<double>(total_commits)
+                                       : 0.0;
+            Logger::log_perf(snap, ipc, cpi, occupancy);
+            return end_run(0, "good_trap");
+          }
+          Logger::log_warn(fmt::format("HIT BAD TRAP (code={})", code));
+          return end_run(1, "bad_trap");
+        }
+      }
 
-      if (need_flush_bru_log) {
-        Logger::maybe_log_flush(snap);
-        Logger::maybe_log_bru(snap);
+      if (any_commit && difftest.enabled() &&
+          !difftest.check_group(cycles, rf)) {
+        Logger::log_warn(fmt::format("DIFFTEST MISMATCH at cycle {}", cycles));
+        return end_run(1, "difftest_mismatch");
       }
 
-      if (need_periodic_log) {
-        Logger::maybe_log_stall(snap);
-        Logger::maybe_log_progress(snap);
+      // A mispredicted branch retires in the cycle the ROB flushes for it.
+      if (any_commit && top->backend_flush_o && branch_prof.enabled()) {
+        branch_prof.mispredict();
       }
 
-      if (need_fe_mismatch_log) {
-        Logger::maybe_log_fe_mismatch(
-            snap, [&](uint32_t addr) { return mem.mem.read_word(addr); });
+      if (any_commit) {
+        no_commit_cycles = 0;
+      } else {
+        no_commit_cycles++;
+      }
+      if (stall_prof.enabled()) stall_prof.cycle(top, any_commit);
+
+      if (need_flush_bru_log || need_periodic_log || need_fe_mismatch_log) {
+        SimStats::Scope t(sim_stats, SimStats::kLog);
+        snap_view.begin(cycles, total_commits, no_commit_cycles, last_commit_pc,
+                        last_commit_inst, rf[10]);
+
+        if (need_flush_bru_log) {
+          Logger::maybe_log_flush(snap_view);
+          Logger::maybe_log_bru(snap_view);
+        }
+
+        if (need_periodic_log) {
+          Logger::maybe_log_stall(snap_view);
+          Logger::maybe_log_progress(snap_view);
+          if (args.progress_interval && cycles &&
+              cycles % args.progress_interval == 0) {
+            sim_stats.log_progress(cycles);
+          }
+        }
+
+        if (need_fe_mismatch_log) {
+          Logger::maybe_log_fe_mismatch(snap_view, [&](uint32_t addr) {
+            return mem.mem.read_word(addr);
+          });
+        }
+      }
+
+      if (profiler.enabled()) profiler.cycle(top);
+
+      uint64_t done = cycles + 1;
+      st.cycles = done;
+      if (perf_series.is_open() && done % perf_series.interval() == 0) {
+        perf_series.sample(top, done);
+      }
+      if (done == args.save_checkpoint_at ||
+          (args.checkpoint_every && done % args.checkpoint_every == 0)) {
+        save_checkpoint(fmt::format("{}.{}.ckpt", args.checkpoint_prefix, done),
+                        ckpt, st);
+      }
+      uint64_t until = 0;
+      if (fork_snaps.due(done)) {
+        serial.flush();
+        if (fork_snaps.take(done, until)) {
+          // Resumed snapshot: replay up to the failure with full tracing.
+          args.result_path.clear();
+          args.max_cycles = std::min(args.max_cycles, until + 1);
+          serial.set_quiet(true);
+          LogConfig replay_log = Logger::config();
+          replay_log.commit_trace = true;
+          Logger::init(replay_log);
+          WaveConfig replay_wave;
+          replay_wave.enabled = true;
+          const char* ext = std::strrchr(WaveTracer::kDefaultPath, '.');
+          replay_wave.path =
+              fmt::format("{}.{}{}", args.checkpoint_prefix, done, ext);
+          replay_wave.start = done;
+          if (wave.open(top, replay_wave)) {
+            Logger::log_info(fmt::format(
+                "[fork  ] replaying cycles [{}, {}] into {}", done, until,
+                replay_wave.path));
+          }
+        }
+      }
+
+      if (wave.trigger_armed(cycles)) {
+        bool hit = false;
+        switch (wave.config().trigger) {
+          case WaveConfig::Trigger::kFlush:
+            hit = top->backend_flush_o;
+            break;
+          case WaveConfig::Trigger::kStall:
+            hit = no_commit_cycles == args.stall_threshold;
+            break;
+          case WaveConfig::Trigger::kPc:
+            hit = trigger_pc_hit;
+            break;
+          case WaveConfig::Trigger::kNone:
+            break;
+        }
+        if (hit) {
+          wave.fire(top, done);
+        } else if (wave.ring_due(done) && wave.ring_take(top, done)) {
+          // Resumed pre-trigger snapshot: replay the window silently, as
+          // the parent has shown this output already.
+          args.max_cycles = std::min(args.max_cycles, wave.window_end());
+          args.save_checkpoint_at = args.checkpoint_every = 0;
+          std::fflush(stdout);
+          int null_fd = open("/dev/null", O_WRONLY);
+          dup2(null_fd, STDOUT_FILENO);
+          dup2(null_fd, STDERR_FILENO);
+          close(null_fd);
+        }
+      }
+
+      if (debugger.enabled() && debugger.check(top, done) &&
+          !debugger.prompt(dbg_ctx)) {
+        return end_run(1, "quit");
       }
     }
-  }
 
-  Logger::log_warn(fmt::format("TIMEOUT after {} cycles", args.max_cycles));
+    Logger::log_warn(fmt::format("TIMEOUT after {} cycles", args.max_cycles));
+    return end_run(1, "timeout");
+  };
 
-  if (tfp) tfp->close();
-  delete top;
-  Logger::shutdown();
-  return 1;
+  if (args.batch_path.empty()) return finish(run());
+
+  // One model instance for the whole list: each image gets fresh memory,
+  // harness state and difftest REF, then a reset of the core.
+  size_t passed = 0;
+  for (const std::string& img : batch_images) {
+    args.img_path = img;
+    st = SimState{};
+    occupancy = Occupancy{};
+    sim_stats = SimStats{};
+    if (args.sim_stats) sim_stats.enable();
+    difftest.clear_ref_mem(mem.mem);
+    difftest.close();
+    mem.mem.clear();
+    if (!mem.mem.load_binary(img, kPmemBase)) {
+      end_run(1, "error");
+      continue;
+    }
+    if (!args.difftest_so.empty()) {
+      if (!difftest.init(args.difftest_so, mem.mem, kPmemBase)) {
+        end_run(1, "error");
+        continue;
+      }
+    }
+    if (run() == 0) passed++;
+  }
+  Logger::log_info(fmt::format("[batch ] {}/{} passed", passed,
+                               batch_images.size()));
+  return finish(passed == batch_images.size() ? 0 : 1);
 }
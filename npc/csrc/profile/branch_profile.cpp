@@ -0,0 +1,132 @@
+#include "profile/branch_profile.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include "logger/logger.h"
+
+namespace {
+constexpr char kMagic[8] = {'N', 'P', 'C', 'B', 'R', 'T', 'R', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kBufRecords = 1u << 16;
+
+const char *kind_name(BranchProfiler::Kind k) {
+  switch (k) {
+    case BranchProfiler::Kind::kCond: return "conditional";
+    case BranchProfiler::Kind::kJump: return "direct jump";
+    case BranchProfiler::Kind::kIndirect: return "indirect jalr";
+  }
+  return "?";
+}
+}  // namespace
+
+bool BranchProfiler::open_trace(const std::string &path) {
+  fp_ = std::fopen(path.c_str(), "wb");
+  if (!fp_) {
+    std::cerr << "Failed to open branch trace: " << path << "\n";
+    return false;
+  }
+  uint32_t hdr[2] = {kVersion, sizeof(BranchRecord)};
+  std::fwrite(kMagic, sizeof(kMagic), 1, fp_);
+  std::fwrite(hdr, sizeof(hdr), 1, fp_);
+  buf_.reserve(kBufRecords);
+  enabled_ = true;
+  return true;
+}
+
+void BranchProfiler::close() {
+  if (!fp_) return;
+  std::fwrite(buf_.data(), sizeof(BranchRecord), buf_.size(), fp_);
+  buf_.clear();
+  std::fclose(fp_);
+  fp_ = nullptr;
+}
+
+void BranchProfiler::resolve(uint32_t next_pc) {
+  has_pending_ = false;
+  pending_.target = next_pc;
+  pending_.taken = next_pc != pending_.pc + 4;
+
+  auto [it, inserted] = stats_.try_emplace(pending_.pc);
+  BranchStats &b = it->second;
+  if (inserted) b.kind = static_cast<Kind>(pending_.kind);
+  b.execs++;
+  b.taken += pending_.taken;
+  if (pending_.mispred) {
+    if (b.mispreds) b.mispred_dist_sum += b.execs - b.last_mispred_exec;
+    b.mispreds++;
+    b.last_mispred_exec = b.execs;
+  }
+
+  if (fp_) {
+    buf_.push_back(pending_);
+    if (buf_.size() == kBufRecords) {
+      std::fwrite(buf_.data(), sizeof(BranchRecord), buf_.size(), fp_);
+      buf_.clear();
+    }
+  }
+}
+
+void BranchProfiler::retire(uint32_t pc, uint32_t inst) {
+  retired_++;
+  if (has_pending_) resolve(pc);
+  pending_.mispred = 0;
+
+  Kind kind;
+  switch (inst & 0x7Fu) {
+    case 0x63: kind = Kind::kCond; break;
+    case 0x6F: kind = Kind::kJump; break;
+    case 0x67: kind = Kind::kIndirect; break;
+    default: return;
+  }
+  has_pending_ = true;
+  pending_ = BranchRecord{pc, 0, static_cast<uint8_t>(kind), 0, 0, 0};
+}
+
+void BranchProfiler::report(size_t top_n, const SymbolTable *syms) const {
+  uint64_t execs = 0;
+  uint64_t mispreds = 0;
+  for (const auto &[pc, b] : stats_) {
+    execs += b.execs;
+    mispreds += b.mispreds;
+  }
+  double mpki = retired_ ? 1000.0 * mispreds / retired_ : 0.0;
+  Logger::log_info(fmt::format(
+      "[branch] static={} dynamic={} mispredicts={} ({:.2f}%) MPKI={:.3f}",
+      stats_.size(), execs, mispreds,
+      execs ? 100.0 * mispreds / execs : 0.0, mpki));
+
+  for (Kind kind : {Kind::kCond, Kind::kJump, Kind::kIndirect}) {
+    std::vector<std::pair<uint32_t, const BranchStats *>> rows;
+    for (const auto &[pc, b] : stats_) {
+      if (b.kind == kind && b.mispreds) rows.emplace_back(pc, &b);
+    }
+    if (rows.empty()) continue;
+    size_t shown = std::min(top_n, rows.size());
+    std::partial_sort(rows.begin(), rows.begin() + shown, rows.end(),
+                      [](const auto &x, const auto &y) {
+                        return x.second->mispreds > y.second->mispreds ||
+                               (x.second->mispreds == y.second->mispreds &&
+                                x.first < y.first);
+                      });
+    Logger::log_info(fmt::format("[branch] {}: top {} of {} mispredicting",
+                                 kind_name(kind), shown, rows.size()));
+    Logger::log_info(fmt::format(
+        "[branch]   {:>10} {:>12} {:>7} {:>10} {:>7} {:>9}  {}", "pc",
+        "execs", "taken%", "mispred", "miss%", "avg_dist", "function"));
+    for (size_t i = 0; i < shown; i++) {
+      const BranchStats &b = *rows[i].second;
+      double dist = b.mispreds > 1 ? static_cast<double>(b.mispred_dist_sum) /
+                                         (b.mispreds - 1)
+                                   : 0.0;
+      Logger::log_info(fmt::format(
+          "[branch]   0x{:08x} {:>12} {:>6.1f}% {:>10} {:>6.1f}% {:>9.1f}  {}",
+          rows[i].first, b.execs, 100.0 * b.taken / b.execs, b.mispreds,
+          100.0 * b.mispreds / b.execs, dist,
+          syms ? syms->name(syms->lookup(rows[i].first)) : ""));
+    }
+  }
+}
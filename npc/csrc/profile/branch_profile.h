@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "profile/symbols.h"
+
+// Branch outcome stream written by --branch-trace: a 16-byte header
+// {"NPCBRTR\0", version, record_size} followed by one record per retired
+// control-flow instruction, in retire order.
+struct BranchRecord {
+  uint32_t pc;
+  uint32_t target;  // next retired PC
+  uint8_t kind;     // BranchProfiler::Kind
+  uint8_t taken;
+  uint8_t mispred;
+  uint8_t reserved;
+};
+static_assert(sizeof(BranchRecord) == 12, "BranchRecord layout");
+
+// Per-static-branch statistics built from the retire stream, so wrong-path
+// executions seen by the BRU are not counted. The outcome of a branch is
+// known once the next instruction retires; a mispredict is a ROB flush in
+// the cycle the branch retires.
+class BranchProfiler {
+ public:
+  enum class Kind : uint8_t { kCond, kJump, kIndirect };
+
+  ~BranchProfiler() { close(); }
+
+  void enable() { enabled_ = true; }
+  bool enabled() const { return enabled_; }
+  bool open_trace(const std::string &path);
+  void close();
+
+  void retire(uint32_t pc, uint32_t inst);
+  // The last retired instruction was followed by a ROB flush.
+  void mispredict() { pending_.mispred = 1; }
+
+  // Top-N branches by mispredicts, per kind; `syms` may be null.
+  void report(size_t top_n, const SymbolTable *syms) const;
+
+ private:
+  struct BranchStats {
+    Kind kind;
+    uint64_t execs = 0;
+    uint64_t taken = 0;
+    uint64_t mispreds = 0;
+    uint64_t last_mispred_exec = 0;
+    uint64_t mispred_dist_sum = 0;  // executions between mispredicts
+  };
+
+  void resolve(uint32_t next_pc);
+
+  bool enabled_ = false;
+  bool has_pending_ = false;
+  BranchRecord pending_{};
+  std::unordered_map<uint32_t, BranchStats> stats_;
+  uint64_t retired_ = 0;
+
+  FILE *fp_ = nullptr;
+  std::vector<BranchRecord> buf_;
+};
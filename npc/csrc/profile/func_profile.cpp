@@ -0,0 +1,173 @@
+#include "profile/func_profile.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "Vtb_triathlon.h"
+#include "logger/logger.h"
+
+namespace {
+bool is_link(uint32_t r) { return r == 1 || r == 5; }
+
+// The RTL counts cycles spent in the cache miss states.
+uint64_t icache_miss_cycles(const Vtb_triathlon *top) {
+  return top->perf_icache_miss_req_cycles_o +
+         top->perf_icache_wait_refill_cycles_o;
+}
+uint64_t dcache_miss_cycles(const Vtb_triathlon *top) {
+  return top->perf_dcache_miss_req_cycles_o +
+         top->perf_dcache_wait_refill_cycles_o;
+}
+}  // namespace
+
+bool FuncProfiler::open(const std::string &elf_path) {
+  if (!symtab_.load_elf(elf_path)) return false;
+  stats_.assign(symtab_.symbols().size() + 1, FuncStats{});
+  nodes_.assign(1, Node{-1, SymbolTable::kUnknown, 0});
+  node_cycles_.assign(1, 0);
+  Logger::log_info(fmt::format("[prof] {} functions from {}",
+                               symtab_.symbols().size(), elf_path));
+  return true;
+}
+
+int FuncProfiler::lookup(uint32_t pc) {
+  // Consecutive lookups mostly hit the same function.
+  if (pc - last_lo_ < last_hi_ - last_lo_) return last_sym_;
+  int sym = symtab_.lookup(pc);
+  if (sym != SymbolTable::kUnknown) {
+    const auto &s = symtab_.symbols()[sym];
+    last_sym_ = sym;
+    last_lo_ = s.addr;
+    last_hi_ = s.addr + s.size;
+  }
+  return sym;
+}
+
+int FuncProfiler::child(int node, int sym) {
+  uint64_t key = (static_cast<uint64_t>(node) << 32) |
+                 static_cast<uint32_t>(sym);
+  auto it = children_.find(key);
+  if (it != children_.end()) return it->second;
+  int id = static_cast<int>(nodes_.size());
+  nodes_.push_back(Node{node, sym, nodes_[node].depth + 1});
+  node_cycles_.push_back(0);
+  children_.emplace(key, id);
+  return id;
+}
+
+void FuncProfiler::retire(uint32_t pc, uint32_t inst) {
+  int sym = lookup(pc);
+  stats(sym).retired++;
+  last_retired_pc_ = pc;
+
+  // Calls and returns take effect at the next retired instruction, which
+  // also resyncs the top of the stack (tail calls, unknown frames).
+  if (pending_ret_ && node_ != 0) node_ = nodes_[node_].parent;
+  if (pending_call_ && nodes_[node_].depth < kMaxDepth) {
+    node_ = child(node_, sym);
+  } else if (node_ == 0) {
+    node_ = child(0, sym);
+  } else if (nodes_[node_].sym != sym) {
+    node_ = child(nodes_[node_].parent, sym);
+  }
+  pending_call_ = false;
+  pending_ret_ = false;
+
+  uint32_t opcode = inst & 0x7Fu;
+  uint32_t rd = (inst >> 7) & 0x1Fu;
+  uint32_t rs1 = (inst >> 15) & 0x1Fu;
+  if (opcode == 0x6F) {
+    pending_call_ = is_link(rd);
+  } else if (opcode == 0x67) {
+    pending_ret_ = is_link(rs1) && (!is_link(rd) || rd != rs1);
+    pending_call_ = is_link(rd);
+  }
+}
+
+void FuncProfiler::start(const Vtb_triathlon *top) {
+  icache_miss_total_ = icache_miss_cycles(top);
+  dcache_miss_total_ = dcache_miss_cycles(top);
+}
+
+void FuncProfiler::cycle(const Vtb_triathlon *top) {
+  uint32_t head_pc =
+      top->dbg_rob_count_o ? top->dbg_rob_head_pc_o : last_retired_pc_;
+  int head = lookup(head_pc);
+  stats(head).cycles++;
+  node_cycles_[node_]++;
+
+  // Charge the increments of the miss counters.
+  uint64_t ic = icache_miss_cycles(top);
+  uint64_t dc = dcache_miss_cycles(top);
+  if (ic != icache_miss_total_) {
+    stats(lookup(icache_miss_line_)).icache_miss_cycles +=
+        ic - icache_miss_total_;
+    icache_miss_total_ = ic;
+  }
+  if (dc != dcache_miss_total_) {
+    stats(head).dcache_miss_cycles += dc - dcache_miss_total_;
+    dcache_miss_total_ = dc;
+  }
+  if (top->dbg_icache_miss_valid_o) {
+    icache_miss_line_ = top->dbg_icache_miss_paddr_o;
+  }
+  if (top->dbg_bru_valid_o && top->dbg_bru_mispred_o) {
+    stats(lookup(top->dbg_bru_pc_o)).mispredicts++;
+  }
+}
+
+void FuncProfiler::report(size_t top_n) const {
+  uint64_t total = 0;
+  std::vector<int> order;
+  for (size_t i = 0; i < stats_.size(); i++) {
+    total += stats_[i].cycles;
+    if (stats_[i].cycles || stats_[i].retired) {
+      order.push_back(static_cast<int>(i) - 1);
+    }
+  }
+  auto st = [&](int sym) -> const FuncStats & { return stats_[sym + 1]; };
+  std::sort(order.begin(), order.end(), [&](int a, int b) {
+    return st(a).cycles > st(b).cycles;
+  });
+  if (order.size() > top_n) order.resize(top_n);
+
+  Logger::log_info(fmt::format(
+      "[prof] {:>6} {:>12} {:>12} {:>6} {:>10} {:>10} {:>8}  {}", "cyc%",
+      "cycles", "retired", "IPC", "ic_miss", "dc_miss", "mispred",
+      "function"));
+  for (int sym : order) {
+    const FuncStats &f = st(sym);
+    double pct = total ? 100.0 * f.cycles / total : 0.0;
+    double ipc = f.cycles ? static_cast<double>(f.retired) / f.cycles : 0.0;
+    Logger::log_info(fmt::format(
+        "[prof] {:>5.1f}% {:>12} {:>12} {:>6.3f} {:>10} {:>10} {:>8}  {}",
+        pct, f.cycles, f.retired, ipc, f.icache_miss_cycles,
+        f.dcache_miss_cycles, f.mispredicts, symtab_.name(sym)));
+  }
+}
+
+bool FuncProfiler::write_folded(const std::string &path) const {
+  std::ofstream out(path);
+  if (!out) {
+    std::cerr << "Failed to write folded stacks: " << path << "\n";
+    return false;
+  }
+  std::vector<const char *> frames;
+  for (size_t id = 1; id < nodes_.size(); id++) {
+    if (node_cycles_[id] == 0) continue;
+    frames.clear();
+    for (int n = static_cast<int>(id); n > 0; n = nodes_[n].parent) {
+      frames.push_back(symtab_.name(nodes_[n].sym));
+    }
+    std::string line;
+    for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+      if (!line.empty()) line += ';';
+      line += *it;
+    }
+    out << line << ' ' << node_cycles_[id] << '\n';
+  }
+  return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "profile/symbols.h"
+
+struct Vtb_triathlon;
+
+// Per-function profile for --elf. Every simulated cycle is charged to the
+// function of the oldest unretired instruction (the ROB head), or of the
+// last retired one while the ROB is empty, so function cycles sum to the
+// run length. D$ miss cycles go to the same function, I$ miss cycles to the
+// function holding the missing line, mispredicts to the branch's function.
+//
+// A shadow call stack is rebuilt from retired jal/jalr (RISC-V link
+// register conventions) to produce folded stacks for flamegraph.pl.
+class FuncProfiler {
+ public:
+  bool open(const std::string &elf_path);
+  bool enabled() const { return !symtab_.symbols().empty(); }
+  const SymbolTable &symbols() const { return symtab_; }
+
+  // Baseline of the cache miss counters after reset or restore.
+  void start(const Vtb_triathlon *top);
+  void retire(uint32_t pc, uint32_t inst);
+  void cycle(const Vtb_triathlon *top);
+
+  void report(size_t top_n) const;
+  bool write_folded(const std::string &path) const;
+
+ private:
+  struct FuncStats {
+    uint64_t cycles = 0;
+    uint64_t retired = 0;
+    uint64_t icache_miss_cycles = 0;
+    uint64_t dcache_miss_cycles = 0;
+    uint64_t mispredicts = 0;
+  };
+  // Call-stack tree node; node 0 is the root (empty stack).
+  struct Node {
+    int parent;
+    int sym;
+    uint32_t depth;
+  };
+  static constexpr uint32_t kMaxDepth = 256;
+
+  int lookup(uint32_t pc);
+  FuncStats &stats(int sym) { return stats_[sym + 1]; }
+  int child(int node, int sym);
+
+  SymbolTable symtab_;
+  std::vector<FuncStats> stats_;  // [0] is [unknown]
+  int last_sym_ = SymbolTable::kUnknown;
+  uint32_t last_lo_ = 0;
+  uint32_t last_hi_ = 0;
+
+  uint32_t last_retired_pc_ = 0;
+  uint32_t icache_miss_line_ = 0;
+  uint64_t icache_miss_total_ = 0;
+  uint64_t dcache_miss_total_ = 0;
+
+  std::vector<Node> nodes_;
+  std::vector<uint64_t> node_cycles_;
+  std::unordered_map<uint64_t, int> children_;
+  int node_ = 0;
+  bool pending_call_ = false;
+  bool pending_ret_ = false;
+};
@@ -0,0 +1,118 @@
+#include "profile/stall_profile.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "Vtb_triathlon.h"
+#include "logger/logger.h"
+
+namespace {
+// decode_pkg::fu_e
+const char *fu_name(uint8_t fu) {
+  static const char *const kNames[] = {"none", "alu", "bru", "lsu",
+                                       "mul",  "div", "csr"};
+  return fu < sizeof(kNames) / sizeof(kNames[0]) ? kNames[fu] : "?";
+}
+constexpr uint8_t kFuLsu = 3;
+
+// The RTL counts cycles spent in the D$ miss states.
+uint64_t dcache_miss_cycles(const Vtb_triathlon *top) {
+  return top->perf_dcache_miss_req_cycles_o +
+         top->perf_dcache_wait_refill_cycles_o;
+}
+}  // namespace
+
+void StallProfiler::start(const Vtb_triathlon *top) {
+  dcache_miss_total_ = dcache_miss_cycles(top);
+}
+
+void StallProfiler::cycle(const Vtb_triathlon *top, bool any_commit) {
+  cycles_++;
+  // A change of the miss counters means the D$ was missing.
+  uint64_t dc = dcache_miss_cycles(top);
+  bool dcache_miss = dc != dcache_miss_total_;
+  dcache_miss_total_ = dc;
+
+  if (any_commit) {
+    cur_ = nullptr;
+    return;
+  }
+  stall_cycles_++;
+  bool sb_full = !top->dbg_sb_alloc_ready_o;
+  if (!top->dbg_rob_count_o) {
+    empty_cycles_++;
+    if (sb_full) empty_sb_full_cycles_++;
+    cur_ = nullptr;
+    return;
+  }
+
+  uint32_t pc = top->dbg_rob_head_pc_o;
+  uint8_t fu = static_cast<uint8_t>(top->dbg_rob_head_fu_o);
+  if (!cur_ || cur_pc_ != pc) {
+    cur_ = &stats_[pc];
+    cur_pc_ = pc;
+    cur_->fu = fu;
+    cur_->episodes++;
+  }
+  Reason why;
+  if (dcache_miss && fu == kFuLsu && !top->dbg_rob_head_complete_o) {
+    why = kDcacheMiss;
+  } else if (!top->dbg_rob_head_complete_o) {
+    why = kExec;
+  } else if (sb_full && top->dbg_rob_head_is_store_o) {
+    why = kSbFull;
+  } else {
+    why = kHeld;
+  }
+  cur_->cycles[why]++;
+  cur_->total++;
+}
+
+void StallProfiler::report(size_t top_n, const SymbolTable *syms) const {
+  auto pct = [](uint64_t n, uint64_t d) { return d ? 100.0 * n / d : 0.0; };
+  uint64_t by_reason[kNumReasons] = {};
+  for (const auto &[pc, s] : stats_) {
+    for (int r = 0; r < kNumReasons; r++) by_reason[r] += s.cycles[r];
+  }
+  Logger::log_info(fmt::format(
+      "[stall ] cycles={} no_commit={} ({:.1f}%) rob_empty={} (sb_full={})"
+      " static={}",
+      cycles_, stall_cycles_, pct(stall_cycles_, cycles_), empty_cycles_,
+      empty_sb_full_cycles_, stats_.size()));
+  Logger::log_info(fmt::format(
+      "[stall ] rob_head dc_miss={} sb_full={} exec={} held={}",
+      by_reason[kDcacheMiss], by_reason[kSbFull], by_reason[kExec],
+      by_reason[kHeld]));
+  if (stats_.empty()) return;
+
+  std::vector<std::pair<uint32_t, const PcStats *>> rows;
+  rows.reserve(stats_.size());
+  for (const auto &[pc, s] : stats_) rows.emplace_back(pc, &s);
+  size_t shown = std::min(top_n, rows.size());
+  std::partial_sort(rows.begin(), rows.begin() + shown, rows.end(),
+                    [](const auto &x, const auto &y) {
+                      return x.second->total > y.second->total ||
+                             (x.second->total == y.second->total &&
+                              x.first < y.first);
+                    });
+  Logger::log_info(fmt::format("[stall ] top {} of {} ROB-head PCs",
+                               shown, rows.size()));
+  Logger::log_info(fmt::format(
+      "[stall ]   {:>10} {:>4} {:>12} {:>6} {:>9} {:>7} {:>6} {:>6} {:>6}"
+      " {:>6}  {}",
+      "pc", "fu", "cycles", "%", "episodes", "avg", "dmiss%", "sbful%",
+      "exec%", "held%", "function"));
+  for (size_t i = 0; i < shown; i++) {
+    const PcStats &s = *rows[i].second;
+    Logger::log_info(fmt::format(
+        "[stall ]   0x{:08x} {:>4} {:>12} {:>5.1f}% {:>9} {:>7.1f} {:>5.1f}%"
+        " {:>5.1f}% {:>5.1f}% {:>5.1f}%  {}",
+        rows[i].first, fu_name(s.fu), s.total, pct(s.total, stall_cycles_),
+        s.episodes, static_cast<double>(s.total) / s.episodes,
+        pct(s.cycles[kDcacheMiss], s.total), pct(s.cycles[kSbFull], s.total),
+        pct(s.cycles[kExec], s.total), pct(s.cycles[kHeld], s.total),
+        syms ? syms->name(syms->lookup(rows[i].first)) : ""));
+  }
+}
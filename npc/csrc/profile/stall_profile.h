@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "profile/symbols.h"
+
+struct Vtb_triathlon;
+
+// Retirement stall attribution for --stall-profile. Every cycle without a
+// commit is charged to the static PC at the ROB head, split by why the head
+// did not retire. Reasons are checked in this order:
+//   dc_miss  the head is a memory op and the D$ was in a miss state
+//   exec     the head has not completed (operands or functional unit)
+//   sb_full  the head is a completed store and the store buffer is full
+//   held     the head has completed but did not retire (e.g. a flush)
+// A full store buffer blocks dispatch, not retirement, so it is only
+// charged to a completed store head; cycles where it drains the ROB show
+// up as rob_empty (sb_full=) instead. Cycles with an empty ROB have no head
+// and are only counted in total.
+//
+// The D$ miss state is read from the registered perf_dcache_* cycle
+// counters, which move one cycle after the state does. A miss is therefore
+// seen one cycle late: its first cycle is charged as exec, and the cycle
+// after the refill as dc_miss.
+class StallProfiler {
+ public:
+  enum Reason { kDcacheMiss, kSbFull, kExec, kHeld, kNumReasons };
+
+  void enable() { enabled_ = true; }
+  bool enabled() const { return enabled_; }
+
+  // Baseline of the D$ miss counters after reset or restore.
+  void start(const Vtb_triathlon *top);
+  // End of a simulated cycle; `any_commit` if the ROB retired anything.
+  void cycle(const Vtb_triathlon *top, bool any_commit);
+
+  // Top-N PCs by stall cycles; `syms` may be null.
+  void report(size_t top_n, const SymbolTable *syms) const;
+
+ private:
+  struct PcStats {
+    uint8_t fu = 0;
+    uint64_t cycles[kNumReasons] = {};
+    uint64_t total = 0;
+    uint64_t episodes = 0;  // maximal stall runs with this PC at the head
+  };
+
+  bool enabled_ = false;
+  std::unordered_map<uint32_t, PcStats> stats_;
+  // Entry of the running stall, so a long stall costs no map lookups.
+  PcStats *cur_ = nullptr;
+  uint32_t cur_pc_ = 0;
+
+  uint64_t cycles_ = 0;
+  uint64_t stall_cycles_ = 0;
+  uint64_t empty_cycles_ = 0;
+  uint64_t empty_sb_full_cycles_ = 0;
+  uint64_t dcache_miss_total_ = 0;
+};
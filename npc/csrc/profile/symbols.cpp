@@ -0,0 +1,73 @@
+#include "profile/symbols.h"
+
+#include <elf.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+template <typename T>
+bool read_at(std::ifstream &in, uint64_t off, T *out, size_t n = 1) {
+  in.seekg(static_cast<std::streamoff>(off));
+  in.read(reinterpret_cast<char *>(out),
+          static_cast<std::streamsize>(sizeof(T) * n));
+  return static_cast<bool>(in);
+}
+}  // namespace
+
+bool SymbolTable::load_elf(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  Elf32_Ehdr ehdr{};
+  if (!in || !read_at(in, 0, &ehdr) ||
+      std::memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0 ||
+      ehdr.e_ident[EI_CLASS] != ELFCLASS32) {
+    std::cerr << "Not an ELF32 file: " << path << "\n";
+    return false;
+  }
+  std::vector<Elf32_Shdr> shdr(ehdr.e_shnum);
+  if (!read_at(in, ehdr.e_shoff, shdr.data(), shdr.size())) {
+    std::cerr << "Failed to read section headers: " << path << "\n";
+    return false;
+  }
+
+  for (const Elf32_Shdr &sh : shdr) {
+    if (sh.sh_type != SHT_SYMTAB || sh.sh_link >= shdr.size()) continue;
+    const Elf32_Shdr &strtab = shdr[sh.sh_link];
+    std::vector<Elf32_Sym> syms(sh.sh_size / sizeof(Elf32_Sym));
+    std::vector<char> strs(strtab.sh_size + 1, '\0');
+    if (!read_at(in, sh.sh_offset, syms.data(), syms.size()) ||
+        !read_at(in, strtab.sh_offset, strs.data(), strtab.sh_size)) {
+      std::cerr << "Failed to read symbol table: " << path << "\n";
+      return false;
+    }
+    for (const Elf32_Sym &s : syms) {
+      if (ELF32_ST_TYPE(s.st_info) != STT_FUNC || s.st_size == 0) continue;
+      if (s.st_name >= strtab.sh_size) continue;
+      syms_.push_back({&strs[s.st_name], s.st_value, s.st_size});
+    }
+  }
+  std::sort(syms_.begin(), syms_.end(),
+            [](const Symbol &a, const Symbol &b) { return a.addr < b.addr; });
+  syms_.erase(std::unique(syms_.begin(), syms_.end(),
+                          [](const Symbol &a, const Symbol &b) {
+                            return a.addr == b.addr;
+                          }),
+              syms_.end());
+  if (syms_.empty()) {
+    std::cerr << "No function symbols in " << path << "\n";
+    return false;
+  }
+  return true;
+}
+
+int SymbolTable::lookup(uint32_t pc) const {
+  auto it = std::upper_bound(
+      syms_.begin(), syms_.end(), pc,
+      [](uint32_t v, const Symbol &s) { return v < s.addr; });
+  if (it == syms_.begin()) return kUnknown;
+  --it;
+  if (pc - it->addr >= it->size) return kUnknown;
+  return static_cast<int>(it - syms_.begin());
+}
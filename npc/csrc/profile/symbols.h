@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Function symbols of an RV32 ELF, sorted by address (see init_elf in
+// nemu/src/cpu/cpu-exec.c for the NEMU counterpart).
+class SymbolTable {
+ public:
+  struct Symbol {
+    std::string name;
+    uint32_t addr;
+    uint32_t size;
+  };
+  static constexpr int kUnknown = -1;
+
+  bool load_elf(const std::string &path);
+
+  // Index of the function containing `pc`, or kUnknown.
+  int lookup(uint32_t pc) const;
+  const std::vector<Symbol> &symbols() const { return syms_; }
+  const char *name(int idx) const {
+    return idx == kUnknown ? "[unknown]" : syms_[idx].name.c_str();
+  }
+
+ private:
+  std::vector<Symbol> syms_;
+};
@@ -60,6 +60,14 @@ static inline uint32_t insn_add(uint32_t rd, uint32_t rs1, uint32_t rs2) {
   return enc_r(0x00, rs2, rs1, 0x0, rd, 0x33);
 }
 
+static inline uint32_t insn_div(uint32_t rd, uint32_t rs1, uint32_t rs2) {
+  return enc_r(0x01, rs2, rs1, 0x4, rd, 0x33);
+}
+
+static inline uint32_t insn_lui(uint32_t rd, uint32_t imm20) {
+  return (imm20 << 12) | (rd << 7) | 0x37;
+}
+
 static inline uint32_t insn_lw(uint32_t rd, uint32_t rs1, int32_t imm) {
   return enc_i(imm, rs1, 0x2, rd, 0x03);
 }
@@ -368,6 +376,48 @@ static void test_load_miss_refill(Vtb_backend *top, MemModel &mem) {
   expect(ok, "Load miss -> refill -> commit");
 }
 
+// A ready device load must not take the single-entry LSU ahead of an older
+// load whose base register is still being computed: it may only issue at
+// the ROB head, which the older load has to pass first.
+static void test_mmio_load_behind_unready_load(Vtb_backend *top,
+                                               MemModel &mem) {
+  std::array<uint32_t, 32> rf{};
+  std::vector<uint32_t> commits;
+
+  reset(top, mem);
+
+  uint32_t addr = 0x200;
+  uint32_t mmio_addr = 0xa00003f8;
+  uint32_t expected = MemModel::make_pattern(addr & ~(LINE_BYTES - 1));
+  uint32_t expected_mmio = MemModel::make_pattern(mmio_addr);
+
+  std::array<uint32_t, 4> group = {
+      insn_addi(4, 0, addr),   // x4 = 0x200
+      insn_addi(5, 0, 1),      // x5 = 1
+      insn_lui(7, 0xa0000),    // x7 = device base
+      insn_nop()};
+  send_group(top, mem, rf, commits, 0xB000, group);
+
+  std::array<uint32_t, 4> group2 = {
+      insn_div(3, 4, 5),       // x3 = 0x200, multi-cycle
+      insn_lw(2, 3, 0),        // older load, base not ready
+      insn_lw(6, 7, 0x3f8),    // device load, base ready
+      insn_nop()};
+  send_group(top, mem, rf, commits, 0xB010, group2);
+
+  bool mmio_early = false;
+  bool ok = run_until(top, mem, rf, commits, [&]() {
+    if (top->dcache_miss_req_valid_o &&
+        (top->dcache_miss_req_paddr_o >> 28) == 0xA && rf[2] != expected) {
+      mmio_early = true;
+    }
+    return rf[2] == expected && rf[6] == expected_mmio;
+  }, 1000);
+
+  expect(ok, "MMIO load behind an unready older load commits");
+  expect(!mmio_early, "MMIO load issued only after the older load retired");
+}
+
 int main(int argc, char **argv) {
   Verilated::commandArgs(argc, argv);
   Vtb_backend *top = new Vtb_backend;
@@ -379,6 +429,7 @@ int main(int argc, char **argv) {
   test_branch_flush(top, mem);
   test_store_load_forward(top, mem);
   test_load_miss_refill(top, mem);
+  test_mmio_load_behind_unready_load(top, mem);
 
   std::cout << ANSI_RES_GRN << "--- [ALL BACKEND TESTS PASSED] ---" << ANSI_RES_RST << std::endl;
   delete top;
@@ -180,6 +180,87 @@ void send_store(Vtb_dcache *top, VerilatedVcdC *tfp, uint32_t addr,
   }
 }
 
+// 设备地址的 Load: 不查 Cache，直接以字节地址发 miss 请求，Refill 不分配
+void check_uncached_load(Vtb_dcache *top, VerilatedVcdC *tfp, uint32_t addr,
+                         uint32_t data, const char *msg) {
+  wait_until_ready(top, tfp, false);
+  top->ld_req_valid_i = 1;
+  top->ld_req_addr_i = addr;
+  top->ld_req_op_i = 2; // LW
+  tick(top, tfp);
+  top->ld_req_valid_i = 0;
+
+  int timeout = 0;
+  while (!top->miss_req_valid_o && timeout++ < 20) {
+    if (top->wb_req_valid_o || top->ld_rsp_valid_o) {
+      std::cout << "[FAIL] " << msg << " (expected a miss request)"
+                << std::endl;
+      assert(false);
+    }
+    tick(top, tfp);
+  }
+  if (top->miss_req_paddr_o != addr) {
+    std::cout << "[FAIL] " << msg << " miss paddr=" << std::hex
+              << top->miss_req_paddr_o << std::endl;
+    assert(false);
+  }
+  handle_memory_interaction(top, tfp, data);
+
+  timeout = 0;
+  while (!top->ld_rsp_valid_o && timeout++ < 20)
+    tick(top, tfp);
+  if (top->ld_rsp_data_o != data) {
+    std::cout << "[FAIL] " << msg << " Exp=" << std::hex << data
+              << " Got=" << top->ld_rsp_data_o << std::endl;
+    assert(false);
+  }
+  std::cout << "[PASS] " << msg << std::endl;
+  top->ld_rsp_ready_i = 1;
+  tick(top, tfp);
+  top->ld_rsp_ready_i = 0;
+}
+
+// 设备地址的 Store: 一个字的 writeback，之后直接回到 IDLE（不 refill）
+void check_uncached_store(Vtb_dcache *top, VerilatedVcdC *tfp, uint32_t addr,
+                          uint32_t data, int op, const char *msg) {
+  wait_until_ready(top, tfp, true);
+  top->st_req_valid_i = 1;
+  top->st_req_addr_i = addr;
+  top->st_req_data_i = data;
+  top->st_req_op_i = op;
+  tick(top, tfp);
+  top->st_req_valid_i = 0;
+
+  int timeout = 0;
+  while (!top->wb_req_valid_o && timeout++ < 20) {
+    if (top->miss_req_valid_o) {
+      std::cout << "[FAIL] " << msg << " (unexpected refill)" << std::endl;
+      assert(false);
+    }
+    tick(top, tfp);
+  }
+  uint32_t word = (addr & 0x1f) >> 2;
+  if (top->wb_req_paddr_o != addr || top->wb_req_data_o[word] != data) {
+    std::cout << "[FAIL] " << msg << " wb paddr=" << std::hex
+              << top->wb_req_paddr_o << " data=" << top->wb_req_data_o[word]
+              << std::endl;
+    assert(false);
+  }
+  top->wb_req_ready_i = 1;
+  tick(top, tfp);
+  top->wb_req_ready_i = 0;
+
+  timeout = 0;
+  while (!top->st_req_ready_o && timeout++ < 20) {
+    if (top->miss_req_valid_o || top->wb_req_valid_o) {
+      std::cout << "[FAIL] " << msg << " (extra memory request)" << std::endl;
+      assert(false);
+    }
+    tick(top, tfp);
+  }
+  std::cout << "[PASS] " << msg << std::endl;
+}
+
 // -------------------------------------------------------------------------
 // Main Test Bench
 // -------------------------------------------------------------------------
@@ -310,6 +391,22 @@ int main(int argc, char **argv) {
   else
     std::cout << "[FAIL] Case 7: No Error on Misalignment." << std::endl;
 
+  // ============================================================
+  // Test 8: Uncached Device Access (bypass, no allocation)
+  // ============================================================
+  std::cout << "[TEST] Case 8: Uncached Device Access" << std::endl;
+  // 先接收 Case 7 留下的错误响应
+  top->ld_rsp_ready_i = 1;
+  tick(top, tfp);
+  top->ld_rsp_ready_i = 0;
+  uint32_t mmio = 0xa00003f8;
+  check_uncached_load(top, tfp, mmio, 0x41, "Case 8: Uncached load");
+  // 没有分配: 再读一次必须重新发请求，拿到新数据
+  check_uncached_load(top, tfp, mmio, 0x42, "Case 8: Uncached load again");
+  check_uncached_store(top, tfp, mmio, 0x55, OP_SW, "Case 8: Uncached store");
+  check_uncached_load(top, tfp, mmio, 0x43,
+                      "Case 8: Uncached load after store");
+
   // Cleanup
   for (int i = 0; i < 20; i++)
     tick(top, tfp);
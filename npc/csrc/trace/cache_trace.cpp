@@ -0,0 +1,70 @@
+#include "trace/cache_trace.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace {
+constexpr char kMagic[8] = {'N', 'P', 'C', 'C', 'T', 'R', 'C', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kBufRecords = 1u << 16;
+}  // namespace
+
+bool CacheTraceWriter::open(const std::string &path) {
+  fp_ = std::fopen(path.c_str(), "wb");
+  if (!fp_) {
+    std::cerr << "Failed to open cache trace: " << path << "\n";
+    return false;
+  }
+  CacheTraceHeader hdr{};
+  std::memcpy(hdr.magic, kMagic, sizeof(kMagic));
+  hdr.version = kVersion;
+  hdr.record_size = sizeof(CacheAccess);
+  std::fwrite(&hdr, sizeof(hdr), 1, fp_);
+  buf_.assign(kBufRecords, CacheAccess{});
+  used_ = 0;
+  return true;
+}
+
+void CacheTraceWriter::flush() {
+  if (!fp_ || used_ == 0) return;
+  std::fwrite(buf_.data(), sizeof(CacheAccess), used_, fp_);
+  used_ = 0;
+}
+
+void CacheTraceWriter::close() {
+  if (!fp_) return;
+  flush();
+  std::fclose(fp_);
+  fp_ = nullptr;
+}
+
+bool CacheTraceReader::open(const std::string &path) {
+  fp_ = std::fopen(path.c_str(), "rb");
+  if (!fp_) {
+    std::cerr << "Failed to open cache trace: " << path << "\n";
+    return false;
+  }
+  CacheTraceHeader hdr{};
+  if (std::fread(&hdr, sizeof(hdr), 1, fp_) != 1 ||
+      std::memcmp(hdr.magic, kMagic, sizeof(kMagic)) != 0 ||
+      hdr.version != kVersion || hdr.record_size != sizeof(CacheAccess)) {
+    std::cerr << "Not a v" << kVersion << " cache trace: " << path << "\n";
+    close();
+    return false;
+  }
+  return true;
+}
+
+void CacheTraceReader::close() {
+  if (!fp_) return;
+  std::fclose(fp_);
+  fp_ = nullptr;
+}
+
+const std::vector<CacheAccess> &CacheTraceReader::next_chunk() {
+  buf_.resize(kBufRecords);
+  size_t n = 0;
+  if (fp_) n = std::fread(buf_.data(), sizeof(CacheAccess), buf_.size(), fp_);
+  buf_.resize(n);
+  return buf_;
+}
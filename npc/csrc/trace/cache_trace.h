@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Demand access stream for --cache-trace: a 16-byte header
+// {"NPCCTRC\0", version, record_size} followed by 8-byte records in the
+// order the caches accept them (I$ fetch-group requests, D$ load requests
+// and store-buffer writes; MMIO is left out). Replayed against many cache
+// geometries by tools/cache_sim.cpp.
+struct CacheAccess {
+  enum Kind : uint8_t { kFetch = 0, kLoad = 1, kStore = 2 };
+  uint32_t addr;
+  uint8_t kind;
+  uint8_t reserved[3];
+};
+static_assert(sizeof(CacheAccess) == 8, "CacheAccess layout");
+
+struct CacheTraceHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t record_size;
+};
+
+class CacheTraceWriter {
+ public:
+  ~CacheTraceWriter() { close(); }
+
+  bool open(const std::string &path);
+  void close();
+  bool is_open() const { return fp_ != nullptr; }
+
+  void append(uint32_t addr, CacheAccess::Kind kind) {
+    CacheAccess &r = buf_[used_++];
+    r.addr = addr;
+    r.kind = kind;
+    if (used_ == buf_.size()) flush();
+  }
+  void flush();
+
+ private:
+  FILE *fp_ = nullptr;
+  std::vector<CacheAccess> buf_;
+  size_t used_ = 0;
+};
+
+class CacheTraceReader {
+ public:
+  ~CacheTraceReader() { close(); }
+
+  bool open(const std::string &path);
+  void close();
+  // Next chunk of records; empty at the end of the trace.
+  const std::vector<CacheAccess> &next_chunk();
+
+ private:
+  FILE *fp_ = nullptr;
+  std::vector<CacheAccess> buf_;
+};
@@ -0,0 +1,102 @@
+#include "trace/commit_log.h"
+
+#include <iostream>
+
+namespace {
+constexpr char kMagic[8] = {'N', 'P', 'C', 'C', 'L', 'O', 'G', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kBufRecords = 1u << 16;
+
+bool ends_with(const std::string &s, const char *suffix) {
+  size_t n = std::strlen(suffix);
+  return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+// Compressed logs go through the compressor's CLI; returns "" for raw.
+std::string pipe_command(const std::string &path, bool write) {
+  const char *tool = nullptr;
+  if (ends_with(path, ".zst")) tool = "zstd";
+  if (ends_with(path, ".lz4")) tool = "lz4";
+  if (!tool) return "";
+  std::string quoted = "'" + path + "'";
+  if (write) return std::string(tool) + " -q -f -o " + quoted + " -";
+  return std::string(tool) + " -q -d -c " + quoted;
+}
+}  // namespace
+
+bool CommitLogWriter::open(const std::string &path) {
+  std::string cmd = pipe_command(path, true);
+  piped_ = !cmd.empty();
+  fp_ = piped_ ? popen(cmd.c_str(), "w") : std::fopen(path.c_str(), "wb");
+  if (!fp_) {
+    std::cerr << "Failed to open commit log: " << path << "\n";
+    return false;
+  }
+  CommitLogHeader hdr{};
+  std::memcpy(hdr.magic, kMagic, sizeof(kMagic));
+  hdr.version = kVersion;
+  hdr.record_size = sizeof(CommitRecord);
+  std::fwrite(&hdr, sizeof(hdr), 1, fp_);
+  buf_.resize(kBufRecords);
+  used_ = 0;
+  return true;
+}
+
+void CommitLogWriter::flush() {
+  if (!fp_ || used_ == 0) return;
+  std::fwrite(buf_.data(), sizeof(CommitRecord), used_, fp_);
+  used_ = 0;
+}
+
+void CommitLogWriter::close() {
+  if (!fp_) return;
+  flush();
+  if (piped_) {
+    pclose(fp_);
+  } else {
+    std::fclose(fp_);
+  }
+  fp_ = nullptr;
+}
+
+bool CommitLogReader::open(const std::string &path) {
+  std::string cmd = pipe_command(path, false);
+  piped_ = !cmd.empty();
+  fp_ = piped_ ? popen(cmd.c_str(), "r") : std::fopen(path.c_str(), "rb");
+  if (!fp_) {
+    std::cerr << "Failed to open commit log: " << path << "\n";
+    return false;
+  }
+  CommitLogHeader hdr{};
+  if (std::fread(&hdr, sizeof(hdr), 1, fp_) != 1 ||
+      std::memcmp(hdr.magic, kMagic, sizeof(kMagic)) != 0 ||
+      hdr.version != kVersion || hdr.record_size != sizeof(CommitRecord)) {
+    std::cerr << "Not a v" << kVersion << " commit log: " << path << "\n";
+    close();
+    return false;
+  }
+  buf_.resize(kBufRecords);
+  pos_ = end_ = 0;
+  return true;
+}
+
+void CommitLogReader::close() {
+  if (!fp_) return;
+  if (piped_) {
+    pclose(fp_);
+  } else {
+    std::fclose(fp_);
+  }
+  fp_ = nullptr;
+}
+
+bool CommitLogReader::next(CommitRecord &r) {
+  if (pos_ == end_) {
+    if (!fp_) return false;
+    end_ = std::fread(buf_.data(), sizeof(CommitRecord), buf_.size(), fp_);
+    pos_ = 0;
+    if (end_ == 0) return false;
+  }
+  r = buf_[pos_++];
+  return true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Binary commit log: a 16-byte header followed by fixed 24-byte records,
+// one per retired instruction, in retire order. Files ending in .zst/.lz4
+// are piped through the zstd/lz4 command line tools, so compression runs in
+// a separate process. Decoded offline by tools/commit_log_tool.cpp.
+struct CommitRecord {
+  uint64_t cycle;
+  uint32_t pc;
+  uint32_t inst;
+  uint32_t wdata;
+  uint8_t slot;
+  uint8_t rd;
+  uint8_t we;
+  uint8_t reserved;
+};
+static_assert(sizeof(CommitRecord) == 24, "CommitRecord layout");
+
+struct CommitLogHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t record_size;
+};
+
+class CommitLogWriter {
+ public:
+  ~CommitLogWriter() { close(); }
+
+  bool open(const std::string &path);
+  void close();
+  bool is_open() const { return fp_ != nullptr; }
+
+  void append(uint64_t cycle, uint32_t slot, uint32_t pc, uint32_t inst,
+              bool we, uint32_t rd, uint32_t wdata) {
+    CommitRecord &r = buf_[used_++];
+    r.cycle = cycle;
+    r.pc = pc;
+    r.inst = inst;
+    r.wdata = wdata;
+    r.slot = static_cast<uint8_t>(slot);
+    r.rd = static_cast<uint8_t>(rd);
+    r.we = we;
+    r.reserved = 0;
+    if (used_ == buf_.size()) flush();
+  }
+  void flush();
+
+ private:
+  FILE *fp_ = nullptr;
+  bool piped_ = false;
+  std::vector<CommitRecord> buf_;
+  size_t used_ = 0;
+};
+
+class CommitLogReader {
+ public:
+  ~CommitLogReader() { close(); }
+
+  bool open(const std::string &path);
+  void close();
+  bool next(CommitRecord &r);
+
+ private:
+  FILE *fp_ = nullptr;
+  bool piped_ = false;
+  std::vector<CommitRecord> buf_;
+  size_t pos_ = 0;
+  size_t end_ = 0;
+};
@@ -0,0 +1,282 @@
+#include "trace/pipe_trace.h"
+
+#include <fmt/format.h>
+
+#include <iostream>
+
+#include "Vtb_triathlon.h"
+
+namespace {
+
+constexpr int kFetchWidth = 4;
+constexpr int kRetireWidth = 4;
+constexpr int kNumFus = 7;
+// dbg_issue_valid_o lane order.
+const char *const kFuNames[kNumFus] = {"alu0", "alu1", "alu2", "alu3",
+                                       "bru",  "lsu",  "csr"};
+
+const char *reg(uint32_t r) {
+  static const char *const kAbi[32] = {
+      "zero", "ra", "sp", "gp", "tp",  "t0",  "t1", "t2", "s0", "s1", "a0",
+      "a1",   "a2", "a3", "a4", "a5",  "a6",  "a7", "s2", "s3", "s4", "s5",
+      "s6",   "s7", "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"};
+  return kAbi[r & 31];
+}
+
+int32_t sext(uint32_t v, int bits) {
+  return static_cast<int32_t>(v << (32 - bits)) >> (32 - bits);
+}
+
+// RV32IM + Zicsr mnemonics for the Konata label column.
+std::string disasm(uint32_t inst) {
+  uint32_t op = inst & 0x7F;
+  uint32_t rd = (inst >> 7) & 31;
+  uint32_t f3 = (inst >> 12) & 7;
+  uint32_t rs1 = (inst >> 15) & 31;
+  uint32_t rs2 = (inst >> 20) & 31;
+  uint32_t f7 = inst >> 25;
+  int32_t imm_i = sext(inst >> 20, 12);
+  int32_t imm_s = sext(((inst >> 25) << 5) | ((inst >> 7) & 31), 12);
+  int32_t imm_b = sext(((inst >> 31) << 12) | (((inst >> 7) & 1) << 11) |
+                           (((inst >> 25) & 0x3F) << 5) |
+                           (((inst >> 8) & 0xF) << 1),
+                       13);
+  int32_t imm_j = sext(((inst >> 31) << 20) | (((inst >> 12) & 0xFF) << 12) |
+                           (((inst >> 20) & 1) << 11) |
+                           (((inst >> 21) & 0x3FF) << 1),
+                       21);
+  switch (op) {
+    case 0x37: return fmt::format("lui {},{:#x}", reg(rd), inst >> 12);
+    case 0x17: return fmt::format("auipc {},{:#x}", reg(rd), inst >> 12);
+    case 0x6F: return fmt::format("jal {},{}", reg(rd), imm_j);
+    case 0x67: return fmt::format("jalr {},{}({})", reg(rd), imm_i, reg(rs1));
+    case 0x63: {
+      static const char *const kOps[8] = {"beq", "bne", "?",   "?",
+                                          "blt", "bge", "bltu", "bgeu"};
+      return fmt::format("{} {},{},{}", kOps[f3], reg(rs1), reg(rs2), imm_b);
+    }
+    case 0x03: {
+      static const char *const kOps[8] = {"lb", "lh", "lw", "?",
+                                          "lbu", "lhu", "?", "?"};
+      return fmt::format("{} {},{}({})", kOps[f3], reg(rd), imm_i, reg(rs1));
+    }
+    case 0x23: {
+      static const char *const kOps[8] = {"sb", "sh", "sw", "?",
+                                          "?",  "?",  "?",  "?"};
+      return fmt::format("{} {},{}({})", kOps[f3], reg(rs2), imm_s, reg(rs1));
+    }
+    case 0x13: {
+      static const char *const kOps[8] = {"addi", "slli", "slti", "sltiu",
+                                          "xori", "srli", "ori",  "andi"};
+      if (f3 == 1 || f3 == 5) {
+        const char *name = f3 == 1 ? "slli" : (f7 & 0x20) ? "srai" : "srli";
+        return fmt::format("{} {},{},{}", name, reg(rd), reg(rs1), rs2);
+      }
+      return fmt::format("{} {},{},{}", kOps[f3], reg(rd), reg(rs1), imm_i);
+    }
+    case 0x33: {
+      static const char *const kOps[8] = {"add", "sll", "slt", "sltu",
+                                          "xor", "srl", "or",  "and"};
+      static const char *const kMul[8] = {"mul",  "mulh", "mulhsu", "mulhu",
+                                          "div",  "divu", "rem",    "remu"};
+      const char *name = f7 == 1 ? kMul[f3] : kOps[f3];
+      if (f7 == 0x20) name = f3 == 0 ? "sub" : "sra";
+      return fmt::format("{} {},{},{}", name, reg(rd), reg(rs1), reg(rs2));
+    }
+    case 0x0F: return "fence";
+    case 0x73: {
+      if (f3 == 0) {
+        if (inst == 0x00000073u) return "ecall";
+        if (inst == 0x00100073u) return "ebreak";
+        if (inst == 0x30200073u) return "mret";
+        return "system";
+      }
+      static const char *const kOps[8] = {"?",  "csrrw",  "csrrs",  "csrrc",
+                                          "?", "csrrwi", "csrrsi", "csrrci"};
+      uint32_t csr = inst >> 20;
+      if (f3 & 4) {
+        return fmt::format("{} {},{:#x},{}", kOps[f3], reg(rd), csr, rs1);
+      }
+      return fmt::format("{} {},{:#x},{}", kOps[f3], reg(rd), csr, reg(rs1));
+    }
+    default: return fmt::format(".word {:#010x}", inst);
+  }
+}
+
+}  // namespace
+
+bool PipeTrace::open(const std::string &path, uint64_t start, uint64_t end) {
+  fp_ = std::fopen(path.c_str(), "w");
+  if (!fp_) {
+    std::cerr << "Failed to open pipe trace: " << path << "\n";
+    return false;
+  }
+  start_ = start;
+  end_ = end;
+  return true;
+}
+
+void PipeTrace::close() {
+  if (!fp_) return;
+  std::fclose(fp_);
+  fp_ = nullptr;
+}
+
+// Kanata cycles are relative; the first event sets the absolute origin.
+void PipeTrace::advance() {
+  if (!started_) {
+    std::fprintf(fp_, "Kanata\t0004\nC=\t%llu\n",
+                 static_cast<unsigned long long>(now_));
+    started_ = true;
+  } else if (now_ > last_cycle_) {
+    std::fprintf(fp_, "C\t%llu\n",
+                 static_cast<unsigned long long>(now_ - last_cycle_));
+  }
+  last_cycle_ = now_;
+}
+
+void PipeTrace::stage(Uop &u, const char *name) {
+  if (u.traced) {
+    advance();
+    if (u.stage) {
+      std::fprintf(fp_, "E\t%llu\t0\t%s\n",
+                   static_cast<unsigned long long>(u.id), u.stage);
+    }
+    std::fprintf(fp_, "S\t%llu\t0\t%s\n", static_cast<unsigned long long>(u.id),
+                 name);
+  }
+  u.stage = name;
+}
+
+void PipeTrace::label(const Uop &u, int type, const std::string &text) {
+  if (!u.traced) return;
+  advance();
+  std::fprintf(fp_, "L\t%llu\t%d\t%s\n", static_cast<unsigned long long>(u.id),
+               type, text.c_str());
+}
+
+void PipeTrace::retire(const Uop &u, bool flushed) {
+  if (rob_slot_[u.rob_idx] == &u) rob_slot_[u.rob_idx] = nullptr;
+  if (!u.traced) return;
+  advance();
+  if (u.stage) {
+    std::fprintf(fp_, "E\t%llu\t0\t%s\n", static_cast<unsigned long long>(u.id),
+                 u.stage);
+  }
+  std::fprintf(fp_, "R\t%llu\t%llu\t%d\n",
+               static_cast<unsigned long long>(u.id),
+               static_cast<unsigned long long>(flushed ? 0 : next_retire_++),
+               flushed ? 1 : 0);
+  live_--;
+}
+
+// A new uop, traced if it enters the pipeline inside the window.
+PipeTrace::Uop PipeTrace::create(uint32_t pc) {
+  bool traced = now_ >= start_ && now_ < end_;
+  Uop u{next_seq_++, traced ? next_id_++ : 0, pc, 0, traced, nullptr};
+  if (traced) {
+    live_++;
+    advance();
+    std::fprintf(fp_, "I\t%llu\t%llu\t0\n",
+                 static_cast<unsigned long long>(u.id),
+                 static_cast<unsigned long long>(u.seq));
+  }
+  return u;
+}
+
+// One accepted I$ request becomes a fetch group of kFetchWidth uops.
+void PipeTrace::fetch(uint32_t addr) {
+  for (int i = 0; i < kFetchWidth; i++) {
+    fetched_.push_back(create(addr + 4u * i));
+    stage(fetched_.back(), "F");
+  }
+}
+
+// A fetch group entering the instruction buffer. Requests the frontend
+// dropped on a redirect are retired as flushed; a group with no matching
+// request (e.g. in flight at a restore) starts here.
+void PipeTrace::enqueue(uint32_t pc, const uint32_t *insts) {
+  bool known = false;
+  for (const Uop &u : fetched_) known |= u.pc == pc;
+  if (known) {
+    while (fetched_.front().pc != pc) {
+      retire(fetched_.front(), true);
+      fetched_.pop_front();
+    }
+  }
+  for (int i = 0; i < kFetchWidth; i++) {
+    uint32_t upc = pc + 4u * i;
+    if (!fetched_.empty() && fetched_.front().pc == upc) {
+      ibuf_.push_back(fetched_.front());
+      fetched_.pop_front();
+    } else {
+      ibuf_.push_back(create(upc));
+    }
+    Uop &u = ibuf_.back();
+    label(u, 0, fmt::format("{:08x}: {}", upc, disasm(insts[i])));
+    stage(u, "Ib");
+  }
+}
+
+void PipeTrace::flush_all() {
+  for (std::deque<Uop> *q : {&rob_, &ibuf_, &fetched_}) {
+    for (const Uop &u : *q) retire(u, true);
+    q->clear();
+  }
+}
+
+void PipeTrace::cycle(const Vtb_triathlon *top, uint64_t cycle) {
+  if (!fp_) return;
+  now_ = cycle;
+
+  // Retirement is in order; an unexpected PC means the uops ahead of it
+  // were squashed without a backend flush.
+  for (int i = 0; i < kRetireWidth; i++) {
+    if (!((top->commit_valid_o >> i) & 1)) continue;
+    uint32_t pc = top->commit_pc_o[i];
+    while (!rob_.empty() && rob_.front().pc != pc) {
+      retire(rob_.front(), true);
+      rob_.pop_front();
+    }
+    if (rob_.empty()) continue;
+    retire(rob_.front(), false);
+    rob_.pop_front();
+  }
+
+  for (int i = 0; i < kNumFus; i++) {
+    if (!((top->dbg_wb_valid_o >> i) & 1)) continue;
+    Uop *u = rob_slot_[(top->dbg_wb_rob_idx_o >> (8 * i)) & 0xFF];
+    if (u) stage(*u, "Wb");
+  }
+  for (int i = 0; i < kNumFus; i++) {
+    if (!((top->dbg_issue_valid_o >> i) & 1)) continue;
+    Uop *u = rob_slot_[(top->dbg_issue_rob_idx_o >> (8 * i)) & 0xFF];
+    if (!u) continue;
+    stage(*u, "Ex");
+    label(*u, 1, kFuNames[i]);
+  }
+
+  if (top->backend_flush_o) {
+    flush_all();
+  } else {
+    for (int i = 0; i < kFetchWidth; i++) {
+      if (!((top->dbg_disp_valid_o >> i) & 1) || ibuf_.empty()) continue;
+      rob_.push_back(ibuf_.front());
+      ibuf_.pop_front();
+      Uop &u = rob_.back();
+      u.rob_idx = static_cast<uint8_t>(top->dbg_disp_rob_idx_o >> (8 * i));
+      rob_slot_[u.rob_idx] = &u;
+      stage(u, "Ds");
+    }
+    if (top->dbg_fe_valid_o && top->dbg_fe_ready_o) {
+      uint32_t insts[kFetchWidth];
+      for (int i = 0; i < kFetchWidth; i++) insts[i] = top->dbg_fe_instrs_o[i];
+      enqueue(top->dbg_fe_pc_o, insts);
+    }
+  }
+  if (top->dbg_ifu_req_valid_o && top->dbg_ifu_req_ready_o) {
+    fetch(top->dbg_ifu_req_addr_o);
+  }
+
+  if (now_ >= end_ && live_ == 0) close();
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <string>
+
+struct Vtb_triathlon;
+
+// Per-instruction pipeline trace for --pipe-trace, in the Kanata log format
+// read by the Konata viewer. Instructions are followed from the I$ request
+// that fetched them (F), through the instruction buffer (Ib), dispatch into
+// the ROB (Ds), issue (Ex) and writeback (Wb) until they retire or are
+// flushed. Only instructions fetched in [start, end) are written; the file
+// is closed once the last of them has left the pipeline.
+class PipeTrace {
+ public:
+  ~PipeTrace() { close(); }
+
+  bool open(const std::string &path, uint64_t start, uint64_t end);
+  void close();
+  bool is_open() const { return fp_ != nullptr; }
+
+  // Handshakes of one simulated cycle, read after tick().
+  void cycle(const Vtb_triathlon *top, uint64_t cycle);
+
+ private:
+  struct Uop {
+    uint64_t seq;
+    uint64_t id;  // Kanata id; only meaningful when traced
+    uint32_t pc;
+    uint8_t rob_idx;
+    bool traced;
+    const char *stage;  // open Kanata stage, if any
+  };
+
+  Uop create(uint32_t pc);
+  void fetch(uint32_t addr);
+  void enqueue(uint32_t pc, const uint32_t *insts);
+  void stage(Uop &u, const char *name);
+  void label(const Uop &u, int type, const std::string &text);
+  void retire(const Uop &u, bool flushed);
+  void flush_all();
+  void advance();
+
+  FILE *fp_ = nullptr;
+  uint64_t start_ = 0;
+  uint64_t end_ = UINT64_MAX;
+  uint64_t now_ = 0;
+  uint64_t last_cycle_ = 0;
+  bool started_ = false;
+  uint64_t next_seq_ = 0;
+  uint64_t next_id_ = 0;
+  uint64_t next_retire_ = 0;
+  uint64_t live_ = 0;  // traced uops still in flight
+
+  // In-order stages: fetched, buffered, and dispatched into the ROB.
+  std::deque<Uop> fetched_;
+  std::deque<Uop> ibuf_;
+  std::deque<Uop> rob_;
+  // ROB index -> uop; deque references survive push_back/pop_front.
+  Uop *rob_slot_[256] = {};
+};
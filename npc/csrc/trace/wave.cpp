@@ -0,0 +1,106 @@
+#include "trace/wave.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "Vtb_triathlon.h"
+#include "logger/logger.h"
+
+bool WaveConfig::parse_trigger(const std::string &spec) {
+  if (spec == "flush") {
+    trigger = Trigger::kFlush;
+    return true;
+  }
+  if (spec == "stall") {
+    trigger = Trigger::kStall;
+    return true;
+  }
+  if (spec.rfind("pc=", 0) == 0) {
+    try {
+      size_t idx = 0;
+      std::string pc = spec.substr(3);
+      trigger_pc = static_cast<uint32_t>(std::stoul(pc, &idx, 16));
+      if (idx != pc.size()) return false;
+    } catch (...) {
+      return false;
+    }
+    trigger = Trigger::kPc;
+    return true;
+  }
+  return false;
+}
+
+bool WaveTracer::open(Vtb_triathlon *top, const WaveConfig &cfg) {
+  cfg_ = cfg;
+  if (cfg_.path.empty()) cfg_.path = kDefaultPath;
+  if (cfg_.trigger != WaveConfig::Trigger::kNone && cfg_.pre) {
+    if (!ring_.configure(cfg_.pre, 2)) {
+      Logger::log_warn("[wave] --trace-pre needs a single-threaded model"
+                       " (THREADS=1); use --trace-pre 0 to trace from the"
+                       " trigger on");
+      return false;
+    }
+    // The file is opened by the snapshot that replays the window.
+    return true;
+  }
+  if (!open_file(top)) return false;
+  start_ = cfg_.start;
+  // Until a trigger fires, nothing is dumped.
+  end_ = cfg_.trigger == WaveConfig::Trigger::kNone ? cfg_.end : 0;
+  return true;
+}
+
+bool WaveTracer::open_file(Vtb_triathlon *top) {
+  Verilated::traceEverOn(true);
+  file_ = new File;
+  top->trace(file_, 99);
+  file_->open(cfg_.path.c_str());
+  if (!file_->isOpen()) {
+    Logger::log_warn(fmt::format("[wave] cannot open {}", cfg_.path));
+    close();
+    return false;
+  }
+  // Reset is simulated before cycle 0 and traced with it.
+  begin_cycle(0);
+  return true;
+}
+
+void WaveTracer::close() {
+  if (!file_) return;
+  file_->close();
+  delete file_;
+  file_ = nullptr;
+  active_ = false;
+}
+
+void WaveTracer::fire(Vtb_triathlon *top, uint64_t next_cycle) {
+  fired_ = true;
+  uint64_t start = next_cycle - std::min(cfg_.pre, next_cycle);
+  end_ = next_cycle + cfg_.post;
+  uint64_t from = 0;
+  if (ring_.resume(start, next_cycle, from)) {
+    Logger::log_info(fmt::format(
+        "[wave] trigger at cycle={}, replayed [{}, {}) from the snapshot at"
+        " cycle={} into {}",
+        next_cycle, std::max(start, from), end_, from, cfg_.path));
+    return;
+  }
+  // No snapshot yet, or no ring: trace from the trigger on.
+  if (!file_ && !open_file(top)) return;
+  start_ = next_cycle;
+  Logger::log_info(fmt::format("[wave] trigger at cycle={}, tracing [{}, {})",
+                               next_cycle, start_, end_));
+}
+
+bool WaveTracer::ring_take(Vtb_triathlon *top, uint64_t next_cycle) {
+  uint64_t trigger = 0;
+  if (!ring_.take(next_cycle, trigger)) return false;
+  // Resumed: replay up to the parent's trigger with the window open.
+  fired_ = true;
+  replaying_ = true;
+  if (!open_file(top)) return true;
+  start_ = trigger - std::min(cfg_.pre, trigger);
+  end_ = trigger + cfg_.post;
+  return true;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "checkpoint/fork_snapshot.h"
+
+struct Vtb_triathlon;
+
+#ifdef NPC_TRACE_FST
+#include "verilated_fst_c.h"
+#else
+#include "verilated_vcd_c.h"
+#endif
+
+struct WaveConfig {
+  enum class Trigger { kNone, kFlush, kStall, kPc };
+
+  bool enabled = false;
+  std::string path;  // empty: npc.vcd / npc.fst
+  // Traced cycle window [start, end). With a trigger, `start` is the cycle
+  // from which the trigger is armed instead, and `end` is ignored.
+  uint64_t start = 0;
+  uint64_t end = std::numeric_limits<uint64_t>::max();
+  Trigger trigger = Trigger::kNone;
+  uint32_t trigger_pc = 0;
+  uint64_t pre = 1000;
+  uint64_t post = 1000;
+
+  // "flush", "stall" or "pc=<addr>".
+  bool parse_trigger(const std::string &spec);
+};
+
+// Waveform dumping restricted to a cycle window. The format is fixed when
+// the model is verilated (TRACE_FMT=vcd|fst in the Makefile).
+//
+// In trigger mode the dumped window is [trigger - pre, trigger + post). The
+// cycles before the trigger come from a two-entry ring of copy-on-write
+// fork() snapshots taken every `pre` cycles: when the trigger fires, the
+// parent resumes the one at least `pre` cycles back and waits while it
+// replays into the file and exits; the parent itself never opens the file
+// and continues untraced. Like --fork-snapshot-every this needs a
+// single-threaded model (THREADS=1). With pre == 0 there is no ring, and
+// the open file only starts dumping at the trigger.
+class WaveTracer {
+ public:
+#ifdef NPC_TRACE_FST
+  using File = VerilatedFstC;
+  static constexpr const char *kDefaultPath = "npc.fst";
+#else
+  using File = VerilatedVcdC;
+  static constexpr const char *kDefaultPath = "npc.vcd";
+#endif
+
+  ~WaveTracer() { close(); }
+
+  bool open(Vtb_triathlon *top, const WaveConfig &cfg);
+  void close();
+  bool is_open() const { return file_ != nullptr; }
+  // Moves the traced window of an open file, e.g. to pause and resume
+  // dumping from the debugger.
+  void set_window(uint64_t start, uint64_t end) {
+    start_ = start;
+    end_ = end;
+  }
+
+  // Window check for the cycle about to be simulated.
+  void begin_cycle(uint64_t cycle) {
+    active_ = file_ && cycle >= start_ && cycle < end_;
+  }
+  void dump(uint64_t time) {
+    if (active_) file_->dump(time);
+  }
+
+  bool trigger_armed(uint64_t cycle) const {
+    return cfg_.trigger != WaveConfig::Trigger::kNone && !fired_ &&
+           cycle >= cfg_.start;
+  }
+  const WaveConfig &config() const { return cfg_; }
+
+  // Fires the trigger at the end of a cycle; `next_cycle` is the next cycle
+  // to simulate.
+  void fire(Vtb_triathlon *top, uint64_t next_cycle);
+
+  // Pre-trigger ring, checked at the end of each armed cycle without a
+  // trigger. ring_take() returns true in the resumed snapshot, which has
+  // opened the file and must stop after the window (replaying()).
+  bool ring_due(uint64_t next_cycle) const { return ring_.due(next_cycle); }
+  bool ring_take(Vtb_triathlon *top, uint64_t next_cycle);
+  bool replaying() const { return replaying_; }
+  uint64_t window_end() const { return end_; }
+
+ private:
+  bool open_file(Vtb_triathlon *top);
+
+  WaveConfig cfg_;
+  File *file_ = nullptr;
+  bool active_ = false;
+  uint64_t start_ = 0;
+  uint64_t end_ = 0;
+  bool fired_ = false;
+  ForkSnapshots ring_;
+  bool replaying_ = false;
+};
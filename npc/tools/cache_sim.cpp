@@ -0,0 +1,294 @@
+// Trace-driven cache simulator for `npc --cache-trace`. Evaluates every
+// size x ways x line x policy combination in one pass over the trace.
+//
+//   npc-cachesim <trace> [--stream icache|dcache|both]
+//                [--sizes 1K,2K,...] [--ways 1,2,4,8] [--lines 16,32,64]
+//                [--policy lru,fifo,random]
+//
+// LRU configurations sharing a line size and set count are served by one
+// stack-distance (Mattson) simulation, which yields the misses of every
+// associativity at once. FIFO and random are simulated per configuration.
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "trace/cache_trace.h"
+
+namespace {
+
+enum class Policy { kLru, kFifo, kRandom };
+
+const char *policy_name(Policy p) {
+  switch (p) {
+    case Policy::kLru: return "lru";
+    case Policy::kFifo: return "fifo";
+    case Policy::kRandom: return "random";
+  }
+  return "?";
+}
+
+struct Config {
+  uint32_t size;
+  uint32_t ways;
+  uint32_t line;
+  Policy policy;
+  uint32_t sets() const { return size / (ways * line); }
+};
+
+uint32_t log2u(uint32_t v) {
+  uint32_t n = 0;
+  while ((1u << n) < v) n++;
+  return n;
+}
+
+bool is_pow2(uint32_t v) { return v && (v & (v - 1)) == 0; }
+
+// Per-set LRU stacks truncated at `max_ways`; hist[d] counts hits at stack
+// depth d, hist[max_ways] the accesses that miss at every associativity.
+class StackSim {
+ public:
+  StackSim(uint32_t line, uint32_t sets, uint32_t max_ways)
+      : shift_(log2u(line)),
+        mask_(sets - 1),
+        max_ways_(max_ways),
+        stacks_(sets),
+        hist_(max_ways + 1, 0) {}
+
+  void access(uint32_t addr) {
+    uint32_t tag = addr >> shift_;
+    std::vector<uint32_t> &s = stacks_[tag & mask_];
+    auto it = std::find(s.begin(), s.end(), tag);
+    if (it != s.end()) {
+      hist_[it - s.begin()]++;
+      std::rotate(s.begin(), it, it + 1);
+      return;
+    }
+    hist_[max_ways_]++;
+    if (s.size() < max_ways_) s.push_back(tag);
+    std::rotate(s.begin(), s.end() - 1, s.end());
+    s.front() = tag;
+  }
+
+  uint64_t misses(uint32_t ways) const {
+    uint64_t n = 0;
+    for (uint32_t d = ways; d <= max_ways_; d++) n += hist_[d];
+    return n;
+  }
+
+ private:
+  uint32_t shift_;
+  uint32_t mask_;
+  uint32_t max_ways_;
+  std::vector<std::vector<uint32_t>> stacks_;
+  std::vector<uint64_t> hist_;
+};
+
+class SetSim {
+ public:
+  explicit SetSim(const Config &c)
+      : shift_(log2u(c.line)),
+        mask_(c.sets() - 1),
+        ways_(c.ways),
+        policy_(c.policy),
+        tags_(static_cast<size_t>(c.sets()) * c.ways, kInvalid),
+        next_(c.sets(), 0) {}
+
+  void access(uint32_t addr) {
+    uint32_t tag = addr >> shift_;
+    uint32_t set = tag & mask_;
+    uint32_t *ways = &tags_[static_cast<size_t>(set) * ways_];
+    for (uint32_t w = 0; w < ways_; w++) {
+      if (ways[w] == tag) return;
+    }
+    misses_++;
+    uint32_t victim = ways_;
+    for (uint32_t w = 0; w < ways_ && victim == ways_; w++) {
+      if (ways[w] == kInvalid) victim = w;
+    }
+    if (victim == ways_) {
+      if (policy_ == Policy::kFifo) {
+        victim = next_[set];
+        next_[set] = (next_[set] + 1) % ways_;
+      } else {
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 17;
+        rng_ ^= rng_ << 5;
+        victim = rng_ % ways_;
+      }
+    }
+    ways[victim] = tag;
+  }
+
+  uint64_t misses() const { return misses_; }
+
+ private:
+  static constexpr uint32_t kInvalid = 0xFFFFFFFFu;
+
+  uint32_t shift_;
+  uint32_t mask_;
+  uint32_t ways_;
+  Policy policy_;
+  std::vector<uint32_t> tags_;
+  std::vector<uint32_t> next_;
+  uint32_t rng_ = 0x2545F491u;
+  uint64_t misses_ = 0;
+};
+
+// All simulators for one cache (I$ or D$).
+class Stream {
+ public:
+  Stream(const char *name, const std::vector<Config> &configs)
+      : name_(name), configs_(configs) {
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> max_ways;
+    for (const Config &c : configs_) {
+      if (c.policy != Policy::kLru) continue;
+      uint32_t &w = max_ways[{c.line, c.sets()}];
+      w = std::max(w, c.ways);
+    }
+    for (const auto &[key, ways] : max_ways) {
+      stack_index_[key] = stacks_.size();
+      stacks_.emplace_back(key.first, key.second, ways);
+    }
+    for (const Config &c : configs_) {
+      sets_.push_back(c.policy == Policy::kLru ? nullptr
+                                               : std::make_unique<SetSim>(c));
+    }
+  }
+
+  void access(uint32_t addr) {
+    accesses_++;
+    for (StackSim &s : stacks_) s.access(addr);
+    for (auto &s : sets_) {
+      if (s) s->access(addr);
+    }
+  }
+
+  void report() const {
+    fmt::print("{}: {} accesses\n", name_, accesses_);
+    if (accesses_ == 0) return;
+    fmt::print("  {:>8} {:>5} {:>5} {:>7} {:>12} {:>8}\n", "size", "ways",
+               "line", "policy", "misses", "miss%");
+    for (size_t i = 0; i < configs_.size(); i++) {
+      const Config &c = configs_[i];
+      uint64_t misses =
+          sets_[i] ? sets_[i]->misses()
+                   : stacks_[stack_index_.at({c.line, c.sets()})].misses(
+                         c.ways);
+      fmt::print("  {:>7}K {:>5} {:>5} {:>7} {:>12} {:>7.3f}%\n",
+                 c.size / 1024, c.ways, c.line, policy_name(c.policy),
+                 misses, 100.0 * misses / accesses_);
+    }
+  }
+
+ private:
+  const char *name_;
+  std::vector<Config> configs_;
+  std::vector<StackSim> stacks_;
+  std::map<std::pair<uint32_t, uint32_t>, size_t> stack_index_;
+  std::vector<std::unique_ptr<SetSim>> sets_;
+  uint64_t accesses_ = 0;
+};
+
+std::vector<uint32_t> parse_list(const std::string &s) {
+  std::vector<uint32_t> out;
+  size_t pos = 0;
+  while (pos <= s.size()) {
+    size_t end = s.find(',', pos);
+    if (end == std::string::npos) end = s.size();
+    std::string tok = s.substr(pos, end - pos);
+    if (!tok.empty()) {
+      char *rest = nullptr;
+      uint64_t v = std::strtoull(tok.c_str(), &rest, 0);
+      if (*rest == 'K' || *rest == 'k') v <<= 10;
+      if (*rest == 'M' || *rest == 'm') v <<= 20;
+      out.push_back(static_cast<uint32_t>(v));
+    }
+    pos = end + 1;
+  }
+  return out;
+}
+
+std::string opt_str(int argc, char **argv, const std::string &name,
+                    const std::string &def) {
+  for (int i = 0; i + 1 < argc; i++) {
+    if (argv[i] == name) return argv[i + 1];
+  }
+  return def;
+}
+
+int usage(const char *prog) {
+  fmt::print(stderr,
+             "Usage: {} <trace> [--stream icache|dcache|both]\n"
+             "       [--sizes 1K,2K,...] [--ways 1,2,4,8] [--lines 16,32,64]\n"
+             "       [--policy lru,fifo,random]\n",
+             prog);
+  return 2;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argv[1][0] == '-') return usage(argv[0]);
+  std::string stream = opt_str(argc, argv, "--stream", "both");
+  auto sizes =
+      parse_list(opt_str(argc, argv, "--sizes", "1K,2K,4K,8K,16K,32K,64K"));
+  auto ways = parse_list(opt_str(argc, argv, "--ways", "1,2,4,8"));
+  auto lines = parse_list(opt_str(argc, argv, "--lines", "16,32,64"));
+  std::string policies = opt_str(argc, argv, "--policy", "lru");
+
+  std::vector<Policy> pols;
+  if (policies.find("lru") != std::string::npos) pols.push_back(Policy::kLru);
+  if (policies.find("fifo") != std::string::npos) pols.push_back(Policy::kFifo);
+  if (policies.find("random") != std::string::npos) {
+    pols.push_back(Policy::kRandom);
+  }
+
+  std::vector<Config> configs;
+  for (uint32_t size : sizes) {
+    for (uint32_t w : ways) {
+      for (uint32_t line : lines) {
+        for (Policy p : pols) {
+          Config c{size, w, line, p};
+          if (!is_pow2(line) || w == 0 || size < w * line ||
+              !is_pow2(c.sets())) {
+            continue;
+          }
+          configs.push_back(c);
+        }
+      }
+    }
+  }
+  if (configs.empty()) {
+    fmt::print(stderr, "No valid cache configuration\n");
+    return 1;
+  }
+
+  CacheTraceReader in;
+  if (!in.open(argv[1])) return 1;
+  bool do_i = stream != "dcache";
+  bool do_d = stream != "icache";
+  Stream icache("icache", do_i ? configs : std::vector<Config>{});
+  Stream dcache("dcache", do_d ? configs : std::vector<Config>{});
+  for (;;) {
+    const auto &chunk = in.next_chunk();
+    if (chunk.empty()) break;
+    for (const CacheAccess &a : chunk) {
+      if (a.kind == CacheAccess::kFetch) {
+        if (do_i) icache.access(a.addr);
+      } else if (do_d) {
+        dcache.access(a.addr);
+      }
+    }
+  }
+
+  fmt::print("{} configurations\n", configs.size());
+  if (do_i) icache.report();
+  if (do_d) dcache.report();
+  return 0;
+}
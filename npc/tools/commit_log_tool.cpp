@@ -0,0 +1,174 @@
+// Offline decoder for the binary commit log written by `npc --commit-log`.
+//
+//   npc-commitlog dump <log> [--limit N]
+//   npc-commitlog diff <a> <b> [--context N]
+//   npc-commitlog mix  <log> [--top N]
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trace/commit_log.h"
+
+namespace {
+
+const char *inst_class(uint32_t inst) {
+  uint32_t opcode = inst & 0x7Fu;
+  uint32_t funct3 = (inst >> 12) & 0x7u;
+  uint32_t funct7 = inst >> 25;
+  switch (opcode) {
+    case 0x03: return "load";
+    case 0x23: return "store";
+    case 0x63: return "branch";
+    case 0x6F: return "jal";
+    case 0x67: return "jalr";
+    case 0x37: return "lui";
+    case 0x17: return "auipc";
+    case 0x13: return "alu-imm";
+    case 0x33:
+      if (funct7 == 0x01) return funct3 < 4 ? "mul" : "div";
+      return "alu-reg";
+    case 0x0F: return "fence";
+    case 0x73: return funct3 == 0 ? "system" : "csr";
+    default: return "other";
+  }
+}
+
+std::string format_record(const CommitRecord &r) {
+  std::string s = fmt::format("cycle={} slot={} pc=0x{:08x} inst=0x{:08x}",
+                              r.cycle, r.slot, r.pc, r.inst);
+  if (r.we && r.rd != 0) s += fmt::format(" x{}=0x{:08x}", r.rd, r.wdata);
+  return s;
+}
+
+// Architectural equality: timing (cycle, slot) may differ between runs.
+bool same_effect(const CommitRecord &a, const CommitRecord &b) {
+  bool wa = a.we && a.rd != 0;
+  bool wb = b.we && b.rd != 0;
+  if (a.pc != b.pc || a.inst != b.inst || wa != wb) return false;
+  return !wa || (a.rd == b.rd && a.wdata == b.wdata);
+}
+
+uint64_t opt_u64(int argc, char **argv, const std::string &name,
+                 uint64_t def) {
+  for (int i = 0; i + 1 < argc; i++) {
+    if (argv[i] == name) return std::strtoull(argv[i + 1], nullptr, 0);
+  }
+  return def;
+}
+
+int cmd_dump(const std::string &path, uint64_t limit) {
+  CommitLogReader in;
+  if (!in.open(path)) return 1;
+  CommitRecord r;
+  for (uint64_t n = 0; n < limit && in.next(r); n++) {
+    fmt::print("{}\n", format_record(r));
+  }
+  return 0;
+}
+
+int cmd_diff(const std::string &pa, const std::string &pb, uint64_t context) {
+  CommitLogReader a, b;
+  if (!a.open(pa) || !b.open(pb)) return 1;
+  std::deque<CommitRecord> history;
+  CommitRecord ra, rb;
+  for (uint64_t n = 0;; n++) {
+    bool ha = a.next(ra);
+    bool hb = b.next(rb);
+    if (!ha && !hb) {
+      fmt::print("identical: {} instructions\n", n);
+      return 0;
+    }
+    if (ha && hb && same_effect(ra, rb)) {
+      history.push_back(ra);
+      if (history.size() > context) history.pop_front();
+      continue;
+    }
+    fmt::print("diverge at instruction #{}\n", n);
+    for (const auto &h : history) fmt::print("    {}\n", format_record(h));
+    fmt::print("  a: {}\n", ha ? format_record(ra) : "<end of log>");
+    fmt::print("  b: {}\n", hb ? format_record(rb) : "<end of log>");
+    return 1;
+  }
+}
+
+int cmd_mix(const std::string &path, uint64_t top) {
+  CommitLogReader in;
+  if (!in.open(path)) return 1;
+  std::map<std::string, uint64_t> mix;
+  std::unordered_map<uint32_t, uint64_t> per_pc;
+  uint64_t total = 0;
+  uint64_t first_cycle = 0;
+  uint64_t last_cycle = 0;
+  CommitRecord r;
+  while (in.next(r)) {
+    if (total == 0) first_cycle = r.cycle;
+    last_cycle = r.cycle;
+    total++;
+    mix[inst_class(r.inst)]++;
+    per_pc[r.pc]++;
+  }
+  if (total == 0) {
+    fmt::print("empty log\n");
+    return 0;
+  }
+
+  uint64_t span = last_cycle - first_cycle + 1;
+  fmt::print("instructions={} cycles={} ipc={:.3f}\n", total, span,
+             static_cast<double>(total) / static_cast<double>(span));
+  std::vector<std::pair<std::string, uint64_t>> classes(mix.begin(),
+                                                        mix.end());
+  std::sort(classes.begin(), classes.end(),
+            [](const auto &x, const auto &y) { return x.second > y.second; });
+  fmt::print("instruction mix:\n");
+  for (const auto &[name, n] : classes) {
+    fmt::print("  {:<8} {:>12} {:6.2f}%\n", name, n, 100.0 * n / total);
+  }
+
+  std::vector<std::pair<uint32_t, uint64_t>> pcs(per_pc.begin(),
+                                                 per_pc.end());
+  size_t shown = std::min<size_t>(top, pcs.size());
+  std::partial_sort(pcs.begin(), pcs.begin() + shown, pcs.end(),
+                    [](const auto &x, const auto &y) {
+                      return x.second > y.second ||
+                             (x.second == y.second && x.first < y.first);
+                    });
+  fmt::print("top {} PCs by retire count ({} distinct):\n", shown, pcs.size());
+  for (size_t i = 0; i < shown; i++) {
+    fmt::print("  0x{:08x} {:>12} {:6.2f}%\n", pcs[i].first, pcs[i].second,
+               100.0 * pcs[i].second / total);
+  }
+  return 0;
+}
+
+int usage(const char *prog) {
+  fmt::print(stderr,
+             "Usage: {0} dump <log> [--limit N]\n"
+             "       {0} diff <a> <b> [--context N]\n"
+             "       {0} mix <log> [--top N]\n",
+             prog);
+  return 2;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 3) return usage(argv[0]);
+  std::string cmd = argv[1];
+  if (cmd == "dump") {
+    return cmd_dump(argv[2], opt_u64(argc, argv, "--limit", UINT64_MAX));
+  }
+  if (cmd == "diff" && argc >= 4) {
+    return cmd_diff(argv[2], argv[3], opt_u64(argc, argv, "--context", 8));
+  }
+  if (cmd == "mix") {
+    return cmd_mix(argv[2], opt_u64(argc, argv, "--top", 20));
+  }
+  return usage(argv[0]);
+}
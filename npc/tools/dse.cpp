@@ -0,0 +1,423 @@
+// Design-space exploration: builds one simulator per point of a parameter
+// sweep over test_config_pkg and runs a benchmark set on each build.
+//
+//   npc-dse --spec FILE --regress BIN [-j N] [--run-jobs N] [--timeout SEC]
+//           [--out-dir DIR] [--npc-home DIR] [--make ARG]... IMG...
+//           [-- SIM_ARGS...]
+//
+// The spec lists user_cfg_t fields and their values in YAML/JSON flow form,
+// one field per line or all in one JSON object; unlisted fields keep their
+// value from vsrc/include/test_config_pkg.sv:
+//
+//   ROB_DEPTH: [32, 64, 128]
+//   RS_DEPTH:  [8, 16]
+//
+// Every point gets DIR/<point>/test_config_pkg.sv, a Verilator build in
+// DIR/<point>/build (build.log) and an npc-regress run in DIR/<point>/run.
+// Up to -j points are built and run at once. The IPC x configuration table
+// is printed and written to DIR/dse.csv.
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Options {
+  std::string spec;
+  std::string regress;
+  std::string npc_home = ".";
+  std::string out_dir = "dse";
+  unsigned jobs = 1;
+  unsigned run_jobs = 0;
+  double timeout = 600;
+  std::vector<std::string> make_args;
+  std::vector<std::string> images;
+  std::vector<std::string> sim_args;
+};
+
+struct Param {
+  std::string name;
+  std::vector<std::string> values;
+};
+
+struct Point {
+  std::vector<std::string> values;  // one per Param
+  std::string name;
+  std::string dir;
+  std::string status;  // ok, build_failed, run_failed
+  // Per benchmark: IPC, or the failure status for a failed run.
+  std::map<std::string, std::string> results;
+  double geomean = 0;
+};
+
+std::string read_file(const std::string &path) {
+  std::ifstream in(path);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+std::string abs_path(const std::string &path) {
+  if (!path.empty() && path[0] == '/') return path;
+  char cwd[4096];
+  if (!getcwd(cwd, sizeof(cwd))) return path;
+  return std::string(cwd) + "/" + path;
+}
+
+std::string test_name(const std::string &image) {
+  std::string name = image.substr(image.find_last_of('/') + 1);
+  if (name.size() > 4 && name.compare(name.size() - 4, 4, ".bin") == 0) {
+    name.resize(name.size() - 4);
+  }
+  return name;
+}
+
+bool is_ident(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Accepts `KEY: [v, ...]` / `KEY: v` entries, with or without JSON quotes
+// and braces; `#` starts a comment.
+bool parse_spec(const std::string &text, std::vector<Param> &params) {
+  std::string s;
+  bool comment = false;
+  for (char c : text) {
+    if (c == '#') comment = true;
+    if (c == '\n') comment = false;
+    if (!comment && c != '"' && c != '\'' && c != '{' && c != '}') s += c;
+  }
+  size_t i = 0;
+  auto skip_ws = [&] {
+    while (i < s.size() && std::isspace(static_cast<unsigned char>(s[i]))) i++;
+  };
+  for (;;) {
+    while (i < s.size() && !is_ident(s[i])) i++;
+    if (i == s.size()) break;
+    Param p;
+    while (i < s.size() && is_ident(s[i])) p.name += s[i++];
+    skip_ws();
+    if (i == s.size() || s[i] != ':') {
+      fmt::print(stderr, "spec: expected ':' after {}\n", p.name);
+      return false;
+    }
+    i++;
+    skip_ws();
+    std::string list;
+    if (i < s.size() && s[i] == '[') {
+      size_t end = s.find(']', i);
+      if (end == std::string::npos) {
+        fmt::print(stderr, "spec: unterminated list for {}\n", p.name);
+        return false;
+      }
+      list = s.substr(i + 1, end - i - 1);
+      i = end + 1;
+    } else {
+      while (i < s.size() && s[i] != '\n' && s[i] != ',') list += s[i++];
+    }
+    std::stringstream ls(list);
+    std::string v;
+    while (std::getline(ls, v, ',')) {
+      v.erase(0, v.find_first_not_of(" \t\r\n"));
+      v.erase(v.find_last_not_of(" \t\r\n") + 1);
+      if (v.empty()) continue;
+      if (v.find_first_not_of("0123456789") != std::string::npos) {
+        fmt::print(stderr, "spec: {} value '{}' is not an integer\n", p.name,
+                   v);
+        return false;
+      }
+      p.values.push_back(v);
+    }
+    if (p.values.empty()) {
+      fmt::print(stderr, "spec: no values for {}\n", p.name);
+      return false;
+    }
+    params.push_back(std::move(p));
+  }
+  return !params.empty();
+}
+
+std::regex field_regex(const std::string &name) {
+  return std::regex("(\\b" + name + "\\s*:\\s*unsigned'\\()\\s*\\d+\\s*(\\))");
+}
+
+std::string make_config(std::string base, const std::vector<Param> &params,
+                        const Point &pt) {
+  for (size_t i = 0; i < params.size(); i++) {
+    std::smatch m;
+    if (!std::regex_search(base, m, field_regex(params[i].name))) continue;
+    base = m.prefix().str() + m[1].str() + pt.values[i] + m[2].str() +
+           m.suffix().str();
+  }
+  return base;
+}
+
+// Runs argv with stdout+stderr redirected to `log`; returns the exit code,
+// or -1 if the command could not be started or was killed.
+int run(const std::vector<std::string> &argv, const std::string &log) {
+  std::vector<std::string> args = argv;
+  std::vector<char *> cargs;
+  for (auto &a : args) cargs.push_back(a.data());
+  cargs.push_back(nullptr);
+  pid_t pid = fork();
+  if (pid == 0) {
+    int fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+      dup2(fd, STDOUT_FILENO);
+      dup2(fd, STDERR_FILENO);
+      close(fd);
+    }
+    execvp(cargs[0], cargs.data());
+    _exit(127);
+  }
+  if (pid < 0) return -1;
+  int wstatus = 0;
+  if (waitpid(pid, &wstatus, 0) < 0 || !WIFEXITED(wstatus)) return -1;
+  return WEXITSTATUS(wstatus);
+}
+
+std::vector<std::string> split_csv(const std::string &line) {
+  std::vector<std::string> cells(1);
+  bool quoted = false;
+  for (size_t i = 0; i < line.size(); i++) {
+    char c = line[i];
+    if (c == '"') {
+      if (quoted && i + 1 < line.size() && line[i + 1] == '"') {
+        cells.back() += c;
+        i++;
+      } else {
+        quoted = !quoted;
+      }
+    } else if (c == ',' && !quoted) {
+      cells.emplace_back();
+    } else {
+      cells.back() += c;
+    }
+  }
+  return cells;
+}
+
+// Reads the per-test status and IPC from an npc-regress --csv report.
+void read_report(const std::string &path, Point &pt) {
+  std::ifstream in(path);
+  std::string line;
+  if (!std::getline(in, line)) return;
+  auto header = split_csv(line);
+  auto col = [&](const char *key) {
+    return std::find(header.begin(), header.end(), key) - header.begin();
+  };
+  size_t c_name = col("name");
+  size_t c_status = col("status");
+  size_t c_ipc = col("ipc");
+  while (std::getline(in, line)) {
+    auto cells = split_csv(line);
+    if (c_name >= cells.size() || c_status >= cells.size()) continue;
+    bool ok = cells[c_status] == "good_trap" && c_ipc < cells.size();
+    pt.results[cells[c_name]] = ok ? cells[c_ipc] : cells[c_status];
+  }
+}
+
+void run_point(const Options &opt, const std::string &base,
+               const std::vector<Param> &params, Point &pt) {
+  mkdir(pt.dir.c_str(), 0755);
+  std::string cfg = pt.dir + "/test_config_pkg.sv";
+  std::ofstream(cfg) << make_config(base, params, pt);
+
+  std::string build_dir = pt.dir + "/build";
+  std::vector<std::string> make{"make", "-C", opt.npc_home,
+                                "BUILD_DIR=" + build_dir,
+                                "TEST_CONFIG=" + cfg};
+  make.insert(make.end(), opt.make_args.begin(), opt.make_args.end());
+  if (run(make, pt.dir + "/build.log") != 0) {
+    pt.status = "build_failed";
+    return;
+  }
+
+  std::vector<std::string> regress{opt.regress,
+                                   "--sim", build_dir + "/tb_triathlon",
+                                   "--out-dir", pt.dir + "/run",
+                                   "--csv", pt.dir + "/report.csv",
+                                   "--timeout", fmt::to_string(opt.timeout)};
+  if (opt.run_jobs) {
+    regress.push_back("-j");
+    regress.push_back(fmt::to_string(opt.run_jobs));
+  }
+  regress.insert(regress.end(), opt.images.begin(), opt.images.end());
+  if (!opt.sim_args.empty()) {
+    regress.push_back("--");
+    regress.insert(regress.end(), opt.sim_args.begin(), opt.sim_args.end());
+  }
+  // npc-regress exits 1 when any image fails; the table shows which.
+  int rc = run(regress, pt.dir + "/regress.log");
+  read_report(pt.dir + "/report.csv", pt);
+  pt.status = rc < 0 || pt.results.empty() ? "run_failed" : "ok";
+
+  double log_sum = 0;
+  size_t n = 0;
+  for (const auto &[name, v] : pt.results) {
+    double ipc = std::strtod(v.c_str(), nullptr);
+    if (ipc > 0) {
+      log_sum += std::log(ipc);
+      n++;
+    }
+  }
+  if (n == opt.images.size()) pt.geomean = std::exp(log_sum / n);
+}
+
+bool parse_options(int argc, char **argv, Options &opt) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--") {
+      opt.sim_args.assign(argv + i + 1, argv + argc);
+      break;
+    }
+    if (arg == "--spec" && has_value) {
+      opt.spec = argv[++i];
+    } else if (arg == "--regress" && has_value) {
+      opt.regress = argv[++i];
+    } else if (arg == "--npc-home" && has_value) {
+      opt.npc_home = argv[++i];
+    } else if (arg == "--out-dir" && has_value) {
+      opt.out_dir = argv[++i];
+    } else if (arg == "-j" && has_value) {
+      opt.jobs = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 0));
+    } else if (arg == "--run-jobs" && has_value) {
+      opt.run_jobs =
+          static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 0));
+    } else if (arg == "--timeout" && has_value) {
+      opt.timeout = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--make" && has_value) {
+      opt.make_args.push_back(argv[++i]);
+    } else if (!arg.empty() && arg[0] == '-') {
+      fmt::print(stderr, "Unknown option: {}\n", arg);
+      return false;
+    } else {
+      opt.images.push_back(arg);
+    }
+  }
+  opt.jobs = std::max(1u, opt.jobs);
+  return !opt.spec.empty() && !opt.regress.empty() && !opt.images.empty();
+}
+
+int usage(const char *prog) {
+  fmt::print(stderr,
+             "Usage: {} --spec FILE --regress BIN [-j N] [--run-jobs N]\n"
+             "       [--timeout SEC] [--out-dir DIR] [--npc-home DIR]\n"
+             "       [--make ARG]... IMG... [-- SIM_ARGS...]\n",
+             prog);
+  return 2;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parse_options(argc, argv, opt)) return usage(argv[0]);
+  opt.npc_home = abs_path(opt.npc_home);
+  opt.out_dir = abs_path(opt.out_dir);
+  opt.regress = abs_path(opt.regress);
+  for (auto &img : opt.images) img = abs_path(img);
+
+  std::vector<Param> params;
+  if (!parse_spec(read_file(opt.spec), params)) {
+    fmt::print(stderr, "No parameters in spec {}\n", opt.spec);
+    return 1;
+  }
+  std::string base =
+      read_file(opt.npc_home + "/vsrc/include/test_config_pkg.sv");
+  for (const Param &p : params) {
+    if (!std::regex_search(base, field_regex(p.name))) {
+      fmt::print(stderr, "{} is not a field of test_config_pkg::TestCfg\n",
+                 p.name);
+      return 1;
+    }
+  }
+
+  // Cartesian product, last parameter varying fastest.
+  std::vector<Point> points(1);
+  for (const Param &p : params) {
+    std::vector<Point> next;
+    for (const Point &pt : points) {
+      for (const std::string &v : p.values) {
+        Point q = pt;
+        q.values.push_back(v);
+        q.name += (q.name.empty() ? "" : "_") + p.name + "-" + v;
+        next.push_back(std::move(q));
+      }
+    }
+    points = std::move(next);
+  }
+  mkdir(opt.out_dir.c_str(), 0755);
+  for (Point &pt : points) pt.dir = opt.out_dir + "/" + pt.name;
+  fmt::print("{} points, {} images, {} at a time\n", points.size(),
+             opt.images.size(), opt.jobs);
+  std::fflush(stdout);
+
+  std::atomic<size_t> next{0};
+  std::mutex print_mu;
+  size_t done = 0;
+  std::vector<std::thread> workers;
+  for (unsigned w = 0; w < std::min<size_t>(opt.jobs, points.size()); w++) {
+    workers.emplace_back([&] {
+      for (size_t i; (i = next++) < points.size();) {
+        run_point(opt, base, params, points[i]);
+        std::lock_guard<std::mutex> lock(print_mu);
+        fmt::print("[{}/{}] {} {}\n", ++done, points.size(), points[i].name,
+                   points[i].status);
+        std::fflush(stdout);
+      }
+    });
+  }
+  for (auto &t : workers) t.join();
+
+  std::vector<std::string> benches;
+  for (const auto &img : opt.images) benches.push_back(test_name(img));
+  std::ofstream csv(opt.out_dir + "/dse.csv");
+  for (const Param &p : params) csv << p.name << ",";
+  for (const auto &b : benches) csv << b << ",";
+  csv << "geomean_ipc\n";
+
+  std::string header;
+  for (const Param &p : params) header += fmt::format("{:>12} ", p.name);
+  for (const auto &b : benches) header += fmt::format("{:>12.12} ", b);
+  fmt::print("{}{:>12}\n", header, "geomean");
+  for (const Point &pt : points) {
+    std::string row;
+    for (const auto &v : pt.values) {
+      row += fmt::format("{:>12} ", v);
+      csv << v << ",";
+    }
+    for (const auto &b : benches) {
+      auto it = pt.results.find(b);
+      std::string v = it != pt.results.end() ? it->second : pt.status;
+      row += fmt::format("{:>12.12} ", v);
+      csv << v << ",";
+    }
+    std::string gm = pt.geomean > 0 ? fmt::format("{:.4f}", pt.geomean) : "-";
+    fmt::print("{}{:>12}\n", row, gm);
+    csv << gm << "\n";
+  }
+  fmt::print("results in {}/dse.csv\n", opt.out_dir);
+  return std::all_of(points.begin(), points.end(),
+                     [](const Point &p) { return p.geomean > 0; })
+             ? 0
+             : 1;
+}
@@ -0,0 +1,314 @@
+// Parallel regression runner: runs one simulator binary over many images,
+// one process per image, and merges the `--result` files into a report.
+//
+//   npc-regress --sim BIN [-j N] [--timeout SEC] [--out-dir DIR]
+//               [--json FILE] [--csv FILE] IMG... [-- SIM_ARGS...]
+//
+// Every image gets DIR/<name>.log (stdout+stderr) and DIR/<name>.result.
+// Exits 0 only if every image hits the good trap.
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "logger/json.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::string sim;
+  unsigned jobs = 0;
+  double timeout = 600;
+  std::string out_dir = "regress";
+  std::string json;
+  std::string csv;
+  std::vector<std::string> images;
+  std::vector<std::string> sim_args;
+};
+
+struct Test {
+  std::string name;
+  std::string image;
+  std::string log_path;
+  std::string result_path;
+  pid_t pid = -1;
+  Clock::time_point start;
+  bool killed = false;
+  double seconds = 0;
+  std::string status;
+  int exit_code = -1;
+  // Raw JSON values from the result file, in file order.
+  std::vector<std::pair<std::string, std::string>> fields;
+};
+
+std::string test_name(const std::string &image) {
+  std::string name = image.substr(image.find_last_of('/') + 1);
+  if (name.size() > 4 && name.compare(name.size() - 4, 4, ".bin") == 0) {
+    name.resize(name.size() - 4);
+  }
+  return name;
+}
+
+bool parse_options(int argc, char **argv, Options &opt) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--") {
+      opt.sim_args.assign(argv + i + 1, argv + argc);
+      break;
+    }
+    if (arg == "--sim" && has_value) {
+      opt.sim = argv[++i];
+    } else if (arg == "-j" && has_value) {
+      opt.jobs = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 0));
+    } else if (arg == "--timeout" && has_value) {
+      opt.timeout = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--out-dir" && has_value) {
+      opt.out_dir = argv[++i];
+    } else if (arg == "--json" && has_value) {
+      opt.json = argv[++i];
+    } else if (arg == "--csv" && has_value) {
+      opt.csv = argv[++i];
+    } else if (!arg.empty() && arg[0] == '-') {
+      fmt::print(stderr, "Unknown option: {}\n", arg);
+      return false;
+    } else {
+      opt.images.push_back(arg);
+    }
+  }
+  if (opt.jobs == 0) {
+    opt.jobs = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return !opt.sim.empty() && !opt.images.empty();
+}
+
+void launch(const Options &opt, Test &t) {
+  std::vector<std::string> args{opt.sim, "--result", t.result_path};
+  args.insert(args.end(), opt.sim_args.begin(), opt.sim_args.end());
+  args.push_back(t.image);
+  unlink(t.result_path.c_str());
+
+  t.start = Clock::now();
+  t.pid = fork();
+  if (t.pid == 0) {
+    // Own process group, so a timeout also kills compressor children.
+    setpgid(0, 0);
+    int fd = open(t.log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+      dup2(fd, STDOUT_FILENO);
+      dup2(fd, STDERR_FILENO);
+      close(fd);
+    }
+    std::vector<char *> cargs;
+    for (auto &a : args) cargs.push_back(a.data());
+    cargs.push_back(nullptr);
+    execv(cargs[0], cargs.data());
+    _exit(127);
+  }
+  if (t.pid > 0) {
+    // Also set from the parent: a kill(-pid) before the child has run
+    // setpgid would otherwise miss it.
+    setpgid(t.pid, t.pid);
+  } else if (t.pid < 0) {
+    t.status = "crash";
+    fmt::print(stderr, "fork failed for {}\n", t.name);
+  }
+}
+
+// Reads the `"key": value` lines written by `npc --result`.
+bool read_result(Test &t) {
+  std::ifstream in(t.result_path);
+  if (!in) return false;
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t q0 = line.find('"');
+    size_t q1 = q0 == std::string::npos ? q0 : line.find('"', q0 + 1);
+    size_t colon = q1 == std::string::npos ? q1 : line.find(':', q1);
+    if (colon == std::string::npos) continue;
+    std::string key = line.substr(q0 + 1, q1 - q0 - 1);
+    std::string value = line.substr(colon + 1);
+    value.erase(0, value.find_first_not_of(' '));
+    while (!value.empty() && (value.back() == ',' || value.back() == ' ')) {
+      value.pop_back();
+    }
+    if (key == "status") {
+      t.status = value.size() >= 2 ? value.substr(1, value.size() - 2) : "";
+    } else if (key != "exit_code" && key != "image") {
+      t.fields.emplace_back(key, value);
+    }
+  }
+  return !t.status.empty();
+}
+
+void reap(Test &t, int wstatus) {
+  t.seconds = std::chrono::duration<double>(Clock::now() - t.start).count();
+  t.pid = -1;
+  if (WIFEXITED(wstatus)) t.exit_code = WEXITSTATUS(wstatus);
+  if (t.killed) {
+    t.status = "sim_timeout";
+  } else if (!read_result(t)) {
+    t.status = "crash";
+  }
+}
+
+std::string field(const Test &t, const std::string &key) {
+  for (const auto &[k, v] : t.fields) {
+    if (k == key) return v;
+  }
+  return "";
+}
+
+std::string csv_cell(std::string v) {
+  if (v.size() >= 2 && v.front() == '"') v = v.substr(1, v.size() - 2);
+  if (v.find_first_of(",\"") == std::string::npos) return v;
+  std::string out = "\"";
+  for (char c : v) {
+    if (c == '"') out += '"';
+    out += c;
+  }
+  return out + "\"";
+}
+
+void write_json(const std::string &path, const std::vector<Test> &tests,
+                size_t passed, double seconds) {
+  std::ofstream out(path);
+  out << "{\n  \"summary\": {";
+  out << fmt::format("\"total\": {}, \"passed\": {}, \"failed\": {}, "
+                     "\"wall_seconds\": {:.3f}}},\n",
+                     tests.size(), passed, tests.size() - passed, seconds);
+  out << "  \"tests\": [";
+  for (size_t i = 0; i < tests.size(); i++) {
+    const Test &t = tests[i];
+    out << (i ? ",\n" : "\n") << "    {";
+    out << fmt::format("\"name\": {}, \"image\": {}, \"status\": \"{}\", "
+                       "\"exit_code\": {}, \"wall_seconds\": {:.3f}",
+                       json_string(t.name), json_string(t.image), t.status,
+                       t.exit_code, t.seconds);
+    for (const auto &[k, v] : t.fields) {
+      out << fmt::format(", \"{}\": {}", k, v);
+    }
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+void write_csv(const std::string &path, const std::vector<Test> &tests) {
+  std::vector<std::string> keys;
+  for (const Test &t : tests) {
+    for (const auto &kv : t.fields) {
+      if (std::find(keys.begin(), keys.end(), kv.first) == keys.end()) {
+        keys.push_back(kv.first);
+      }
+    }
+  }
+  std::ofstream out(path);
+  out << "name,status,exit_code,wall_seconds";
+  for (const auto &k : keys) out << "," << k;
+  out << "\n";
+  for (const Test &t : tests) {
+    out << fmt::format("{},{},{},{:.3f}", csv_cell(t.name), t.status,
+                       t.exit_code, t.seconds);
+    for (const auto &k : keys) out << "," << csv_cell(field(t, k));
+    out << "\n";
+  }
+}
+
+int usage(const char *prog) {
+  fmt::print(stderr,
+             "Usage: {} --sim BIN [-j N] [--timeout SEC] [--out-dir DIR]\n"
+             "       [--json FILE] [--csv FILE] IMG... [-- SIM_ARGS...]\n",
+             prog);
+  return 2;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parse_options(argc, argv, opt)) return usage(argv[0]);
+  mkdir(opt.out_dir.c_str(), 0755);
+
+  std::vector<Test> tests(opt.images.size());
+  for (size_t i = 0; i < tests.size(); i++) {
+    Test &t = tests[i];
+    t.image = opt.images[i];
+    t.name = test_name(t.image);
+    t.log_path = opt.out_dir + "/" + t.name + ".log";
+    t.result_path = opt.out_dir + "/" + t.name + ".result";
+  }
+
+  auto begin = Clock::now();
+  auto timeout = std::chrono::duration<double>(opt.timeout);
+  size_t next = 0;
+  size_t running = 0;
+  size_t done = 0;
+  size_t passed = 0;
+  while (done < tests.size()) {
+    while (running < opt.jobs && next < tests.size()) {
+      launch(opt, tests[next]);
+      if (tests[next].pid > 0) {
+        running++;
+      } else {
+        done++;
+      }
+      next++;
+    }
+
+    int wstatus = 0;
+    pid_t pid = waitpid(-1, &wstatus, WNOHANG);
+    if (pid <= 0) {
+      auto now = Clock::now();
+      for (Test &t : tests) {
+        if (t.pid > 0 && !t.killed && now - t.start > timeout) {
+          kill(-t.pid, SIGKILL);
+          t.killed = true;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      continue;
+    }
+    auto it = std::find_if(tests.begin(), tests.end(),
+                           [&](const Test &t) { return t.pid == pid; });
+    if (it == tests.end()) continue;
+    reap(*it, wstatus);
+    running--;
+    done++;
+    bool ok = it->status == "good_trap";
+    if (ok) passed++;
+    std::string detail =
+        ok ? "cycles=" + field(*it, "cycles") : it->status;
+    fmt::print("[{:>{}}/{}] {} {} ({}, {:.2f}s)\n", done,
+               fmt::to_string(tests.size()).size(), tests.size(),
+               ok ? "PASS" : "FAIL", it->name, detail, it->seconds);
+    std::fflush(stdout);
+  }
+  double seconds =
+      std::chrono::duration<double>(Clock::now() - begin).count();
+
+  if (!opt.json.empty()) write_json(opt.json, tests, passed, seconds);
+  if (!opt.csv.empty()) write_csv(opt.csv, tests);
+
+  fmt::print("{}/{} passed in {:.1f}s, logs in {}/\n", passed, tests.size(),
+             seconds, opt.out_dir);
+  for (const Test &t : tests) {
+    if (t.status != "good_trap") {
+      fmt::print("  {}: {} ({}/{}.log)\n", t.name, t.status, opt.out_dir,
+                 t.name);
+    }
+  }
+  return passed == tests.size() ? 0 : 1;
+}
@@ -36,9 +36,9 @@ module backend #(
 
   localparam int unsigned DISPATCH_WIDTH = Cfg.INSTR_PER_FETCH;
   localparam int unsigned COMMIT_WIDTH   = Cfg.NRET;
-  localparam int unsigned ROB_DEPTH      = 64;
+  localparam int unsigned ROB_DEPTH      = Cfg.ROB_DEPTH;
   localparam int unsigned ROB_IDX_WIDTH  = $clog2(ROB_DEPTH);
-  localparam int unsigned SB_DEPTH       = 16;
+  localparam int unsigned SB_DEPTH       = Cfg.SB_DEPTH;
   localparam int unsigned SB_IDX_WIDTH   = $clog2(SB_DEPTH);
   localparam int unsigned RS_DEPTH       = Cfg.RS_DEPTH;
   localparam int unsigned WB_WIDTH       = 7;
@@ -56,7 +56,7 @@ module backend #(
 
   ibuffer #(
       .Cfg         (Cfg),
-      .IB_DEPTH    (16),
+      .IB_DEPTH    (Cfg.IB_DEPTH),
       .DECODE_WIDTH(Cfg.INSTR_PER_FETCH)
   ) u_ibuffer (
       .clk_i (clk_i),
@@ -160,10 +160,17 @@ module reservation_station_lsu #(
   endfunction
 
   // Load/store ordering: block loads behind older stores.
+  // Device (MMIO) loads also wait until they are at the ROB head: reads there
+  // can have side effects (serial RX pop), so they must not run on a wrong
+  // path. Holding them here rather than in the single-entry LSU keeps the
+  // LSU free for the older loads the head is waiting on. The address is
+  // known once rs1 is ready, which ready_mask requires anyway.
   always_comb begin
     for (int m = 0; m < RS_DEPTH; m++) begin
       logic block_load;
+      logic [DATA_W-1:0] ld_addr;
       block_load = 1'b0;
+      ld_addr = v1_arr[m] + op_arr[m].imm;
       if (busy[m] && op_arr[m].is_load) begin
         for (int n = 0; n < RS_DEPTH; n++) begin
           if (busy[n] && op_arr[n].is_store) begin
@@ -172,6 +179,10 @@ module reservation_station_lsu #(
             end
           end
         end
+        if (ld_addr[Cfg.PLEN-1-:4] == config_pkg::MMIO_REGION &&
+            dst_arr[m] != rob_head_i) begin
+          block_load = 1'b1;
+        end
       end
       ready_mask[m] = busy[m] &&
                       (op_arr[m].has_rs1 ? r1_arr[m] : 1'b1) &&
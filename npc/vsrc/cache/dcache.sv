@@ -72,9 +72,20 @@ module dcache #(
   // Tag meta bits: {dirty, valid}
   localparam int unsigned META_WIDTH = 2;
 
+  // Device space (config_pkg::MMIO_REGION) bypasses the arrays: loads fetch
+  // only the addressed word through the miss/refill port, committed stores
+  // go out on the writeback port. Both carry the unaligned request address
+  // so the memory side can decode it. The LSU reservation station only
+  // issues device loads at the ROB head, so their read side effects are not
+  // speculative.
+
   // ---------------------------------------------------------------------------
   // Helper functions (op decode / store merge / load extract)
   // ---------------------------------------------------------------------------
+  function automatic logic is_uncached(input logic [Cfg.PLEN-1:0] addr);
+    return addr[Cfg.PLEN-1-:4] == MMIO_REGION;
+  endfunction
+
   function automatic logic is_load_op(input decode_pkg::lsu_op_e op);
     unique case (op)
       LSU_LB, LSU_LH, LSU_LW, LSU_LD, LSU_LBU, LSU_LHU, LSU_LWU: is_load_op = 1'b1;
@@ -331,6 +342,7 @@ module dcache #(
   logic                [            BANK_SEL_WIDTH-1:0] req_bank_sel_q;
 
   logic                                                 req_err_q;
+  logic                                                 req_uncached_q;
 
   // Miss/victim context
   logic                [Cfg.DCACHE_SET_ASSOC_WIDTH-1:0] victim_way_q;
@@ -525,7 +537,8 @@ module dcache #(
   end
 
   assign lookup_resp_valid =
-      (state_q == S_LOOKUP) && hit && !req_is_store_q && !req_err_q;
+      (state_q == S_LOOKUP) && hit && !req_is_store_q && !req_err_q &&
+      !req_uncached_q;
   assign lookup_resp_data = extract_load(hit_line, req_byte_off_q, req_op_q);
   assign lookup_resp_err  = 1'b0;
 
@@ -587,7 +600,7 @@ module dcache #(
 
       S_WAIT_REFILL: begin
         refill_ready_o = 1'b1;
-        if (refill_valid_i) begin
+        if (refill_valid_i && !req_uncached_q) begin
           // Write refill (load miss) or refill+merge (store miss)
           we_way_mask = '0;
           we_way_mask[refill_way_i] = 1'b1;
@@ -647,6 +660,8 @@ module dcache #(
           end else begin
             state_d = S_IDLE;
           end
+        end else if (req_uncached_q) begin
+          state_d = req_is_store_q ? S_WB_REQ : S_MISS_REQ;
         end else if (hit) begin
           if (req_is_store_q) begin
             state_d = S_STORE_WRITE;
@@ -673,7 +688,7 @@ module dcache #(
 
       S_WB_REQ: begin
         if (wb_req_valid_o && wb_req_ready_i) begin
-          state_d = S_MISS_REQ;
+          state_d = req_uncached_q ? S_IDLE : S_MISS_REQ;
         end
       end
 
@@ -726,6 +741,7 @@ module dcache #(
       req_bank_addr_q  <= '0;
       req_bank_sel_q   <= '0;
       req_err_q        <= 1'b0;
+      req_uncached_q   <= 1'b0;
 
       victim_way_q     <= '0;
       victim_tag_q     <= '0;
@@ -766,6 +782,7 @@ module dcache #(
       req_bank_addr_q  <= '0;
       req_bank_sel_q   <= '0;
       req_err_q        <= 1'b0;
+      req_uncached_q   <= 1'b0;
 
       victim_way_q     <= '0;
       victim_tag_q     <= '0;
@@ -814,6 +831,7 @@ module dcache #(
         req_bank_sel_q  <= sel_bank_sel;
 
         req_err_q       <= is_misaligned(sel_op, sel_addr);
+        req_uncached_q  <= is_uncached(sel_addr);
       end
 
       // ----------------------------------------------------------
@@ -836,6 +854,14 @@ module dcache #(
         // Writeback address from victim tag + current index
         wb_paddr_q       <= {{victim_tag_q, req_index_q}, {OFFSET_WIDTH{1'b0}}};
 
+        // Uncached: keep the byte address, and send the store data in its
+        // lane of an otherwise empty line.
+        if (req_uncached_q) begin
+          miss_paddr_q  <= req_addr_q;
+          wb_paddr_q    <= req_addr_q;
+          victim_line_q <= apply_store('0, req_byte_off_q, req_op_q, req_wdata_q);
+        end
+
         if (req_err_q) begin
           // Only loads have response
           if (!req_is_store_q) begin
@@ -878,7 +904,8 @@ module dcache #(
         last_write_index_q <= req_index_q;
         last_write_way_q   <= store_hit_way_q;
         last_write_line_q  <= store_new_line_q;
-      end else if (state_q == S_WAIT_REFILL && refill_valid_i && refill_ready_o) begin
+      end else if (state_q == S_WAIT_REFILL && refill_valid_i && refill_ready_o &&
+                   !req_uncached_q) begin
         last_write_valid_q <= 1'b1;
         last_write_tag_q   <= refill_paddr_i[Cfg.PLEN-1:OFFSET_WIDTH][INDEX_WIDTH+:TAG_WIDTH];
         last_write_index_q <= miss_index_q;
@@ -37,20 +37,7 @@ module icache_axi_wrapper #(
 );
 
   // ================================================================
-  // =============== 1. Local parameters for AXI ====================
-  // ================================================================
-  localparam int unsigned LINE_BYTES = Cfg.ICACHE_LINE_WIDTH / 8;
-  localparam int unsigned AXI_BYTES = AXI_DATA_WIDTH / 8;
-  localparam int unsigned BEATS_PER_LINE = LINE_BYTES / AXI_BYTES;
-
-  initial begin
-    if (LINE_BYTES % AXI_BYTES != 0) begin
-      $error("ICache line (%0dB) must be multiple of AXI beat (%0dB)", LINE_BYTES, AXI_BYTES);
-    end
-  end
-
-  // ================================================================
-  // =============== 2. Wires between icache and wrapper ============
+  // =============== 1. Wires between icache and wrapper ============
   // ================================================================
   logic                                  miss_req_valid;
   logic                                  miss_req_ready;
@@ -65,7 +52,7 @@ module icache_axi_wrapper #(
   logic [     Cfg.ICACHE_LINE_WIDTH-1:0] refill_data;
 
   // ================================================================
-  // ====================== 3. Instantiate icache ====================
+  // ====================== 2. Instantiate icache ====================
   // ================================================================
   icache #(
       .Cfg(Cfg)
@@ -93,101 +80,46 @@ module icache_axi_wrapper #(
   );
 
   // ================================================================
-  // =================== 4. AXI Read FSM =============================
+  // =================== 3. AXI read master ==========================
   // ================================================================
-  typedef enum logic [1:0] {
-    S_IDLE,
-    S_AR,
-    S_R,
-    S_REFILL
-  } axi_state_e;
-
-  axi_state_e state_q, state_d;
-
-  logic [            AXI_ADDR_WIDTH-1:0] req_addr_q;
-  logic [Cfg.ICACHE_SET_ASSOC_WIDTH-1:0] req_way_q;
-
-  logic [Cfg.ICACHE_LINE_WIDTH-1:0] line_buf_q, line_buf_d;
-  logic [$clog2(BEATS_PER_LINE):0] beat_cnt_q, beat_cnt_d;
-
-  // ========= FSM Combinational =========
-  always_comb begin
-    state_d        = state_q;
-    beat_cnt_d     = beat_cnt_q;
-    line_buf_d     = line_buf_q;
-
-    miss_req_ready = 1'b0;
-
-    refill_valid   = 1'b0;
-    refill_paddr   = req_addr_q;
-    refill_way     = req_way_q;
-    refill_data    = line_buf_q;
-
-    arid_o         = '0;
-    araddr_o       = req_addr_q;
-    arlen_o        = BEATS_PER_LINE - 1;
-    arsize_o       = $clog2(AXI_BYTES);
-    arburst_o      = 2'b01;  // INCR
-    arlock_o       = 1'b0;
-    arcache_o      = 4'b0011;
-    arprot_o       = 3'b000;
-    arqos_o        = 4'b0000;
-    arvalid_o      = 1'b0;
-
-    rready_o       = 1'b0;
-
-    case (state_q)
-      // -----------------------------
-      S_IDLE: begin
-        miss_req_ready = 1'b1;
-        if (miss_req_valid && miss_req_ready) state_d = S_AR;
-      end
-
-      // -----------------------------
-      S_AR: begin
-        arvalid_o = 1'b1;
-        if (arvalid_o && arready_i) begin
-          beat_cnt_d = '0;
-          state_d    = S_R;
-        end
-      end
-
-      // -----------------------------
-      S_R: begin
-        rready_o = 1'b1;
-        if (rvalid_i && rready_o) begin
-          line_buf_d[AXI_DATA_WIDTH*beat_cnt_q+:AXI_DATA_WIDTH] = rdata_i;
-          beat_cnt_d = beat_cnt_q + 1;
-          if (rlast_i) state_d = S_REFILL;
-        end
-      end
-
-      // -----------------------------
-      S_REFILL: begin
-        refill_valid = 1'b1;
-        if (refill_valid && refill_ready) state_d = S_IDLE;
-      end
-    endcase
-  end
-
-  // ========= FSM Sequential =========
-  always_ff @(posedge clk_i or negedge rst_ni) begin
-    if (!rst_ni) begin
-      state_q    <= S_IDLE;
-      beat_cnt_q <= '0;
-      line_buf_q <= '0;
-      req_addr_q <= '0;
-      req_way_q  <= '0;
-    end else begin
-      state_q    <= state_d;
-      beat_cnt_q <= beat_cnt_d;
-      line_buf_q <= line_buf_d;
+  icache_axi_master #(
+      .Cfg           (Cfg),
+      .AXI_ID_WIDTH  (AXI_ID_WIDTH),
+      .AXI_DATA_WIDTH(AXI_DATA_WIDTH),
+      .AXI_ADDR_WIDTH(AXI_ADDR_WIDTH)
+  ) u_axi_master (
+      .clk_i (clk_i),
+      .rst_ni(rst_ni),
 
-      if (state_q == S_IDLE && miss_req_valid && miss_req_ready) begin
-        req_addr_q <= miss_req_paddr;
-        req_way_q  <= miss_req_victim_way;
-      end
-    end
-  end
+      .miss_req_valid_i     (miss_req_valid),
+      .miss_req_ready_o     (miss_req_ready),
+      .miss_req_paddr_i     (miss_req_paddr),
+      .miss_req_victim_way_i(miss_req_victim_way),
+
+      .refill_valid_o(refill_valid),
+      .refill_ready_i(refill_ready),
+      .refill_paddr_o(refill_paddr),
+      .refill_way_o  (refill_way),
+      .refill_data_o (refill_data),
+
+      .arid_o,
+      .araddr_o,
+      .arlen_o,
+      .arsize_o,
+      .arburst_o,
+      .arlock_o,
+      .arcache_o,
+      .arprot_o,
+      .arqos_o,
+      .arvalid_o,
+      .arready_i,
+
+      .rid_i,
+      .rdata_i,
+      .rresp_i,
+      .rlast_i,
+      .rvalid_i,
+      .rready_o
+  );
 
 endmodule
@@ -51,6 +51,11 @@ package build_config_pkg;
 
     // FTQ 配置
     cfg.FTQ_DEPTH = user_cfg.FTQ_DEPTH;
+
+    // IBuffer / ROB / Store Buffer 配置
+    cfg.IB_DEPTH = user_cfg.IB_DEPTH;
+    cfg.ROB_DEPTH = user_cfg.ROB_DEPTH;
+    cfg.SB_DEPTH = user_cfg.SB_DEPTH;
     return cfg;
   endfunction
 endpackage
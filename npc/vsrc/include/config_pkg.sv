@@ -8,6 +8,9 @@ package config_pkg;
   localparam int unsigned ILEN = 32;
   // Number of RETired instructions per cycle
   localparam int unsigned NRET = 4;
+  // Device space, PADDR[PLEN-1 -: 4] (AM/NEMU DEVICE_BASE 0xa0000000,
+  // 256 MiB). Uncached in the D$; loads there are not speculated.
+  localparam logic [3:0] MMIO_REGION = 4'hA;
 
 
   typedef struct packed {
@@ -45,6 +48,13 @@ package config_pkg;
     // Fetch target queue
     int unsigned FTQ_DEPTH;
 
+    // Instruction buffer (power of two)
+    int unsigned IB_DEPTH;
+    // Reorder buffer (power of two)
+    int unsigned ROB_DEPTH;
+    // Store buffer (power of two)
+    int unsigned SB_DEPTH;
+
   } user_cfg_t;
 
   typedef struct packed {
@@ -97,6 +107,11 @@ package config_pkg;
 
     // Fetch target queue
     int unsigned FTQ_DEPTH;
+
+    // Instruction buffer / reorder buffer / store buffer
+    int unsigned IB_DEPTH;
+    int unsigned ROB_DEPTH;
+    int unsigned SB_DEPTH;
   } cfg_t;
   localparam cfg_t EmptyCfg = cfg_t'(0);
 endpackage
@@ -12,6 +12,9 @@ package test_config_pkg;
       RS_DEPTH     : unsigned'(16),
       ALU_COUNT    : unsigned'(2),
       FTQ_DEPTH    : unsigned'(8),
+      IB_DEPTH     : unsigned'(16),
+      ROB_DEPTH    : unsigned'(64),
+      SB_DEPTH     : unsigned'(16),
       ICACHE_BYTE_SIZE : unsigned'(4096),
       ICACHE_SET_ASSOC : unsigned'(4),
       ICACHE_LINE_WIDTH : unsigned'(256),
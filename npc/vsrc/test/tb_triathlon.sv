@@ -4,14 +4,66 @@ import decode_pkg::*;
 import global_config_pkg::*;
 
 module tb_triathlon #(
-    parameter int unsigned ROB_DEPTH = 64,
+    parameter int unsigned ROB_DEPTH = global_config_pkg::Cfg.ROB_DEPTH,
     parameter int unsigned ROB_IDX_W = $clog2(ROB_DEPTH),
-    parameter int unsigned SB_DEPTH  = 16,
+    parameter int unsigned SB_DEPTH  = global_config_pkg::Cfg.SB_DEPTH,
     parameter int unsigned SB_IDX_W  = $clog2(SB_DEPTH)
 ) (
     input logic clk_i,
     input logic rst_ni,
 
+`ifdef NPC_AXI
+    // I-Cache AXI4 read master (ID 0)
+    output logic [         3:0] icache_arid_o,
+    output logic [Cfg.PLEN-1:0] icache_araddr_o,
+    output logic [         7:0] icache_arlen_o,
+    output logic [         2:0] icache_arsize_o,
+    output logic [         1:0] icache_arburst_o,
+    output logic                icache_arvalid_o,
+    input  logic                icache_arready_i,
+
+    input  logic [         3:0] icache_rid_i,
+    input  logic [        63:0] icache_rdata_i,
+    input  logic [         1:0] icache_rresp_i,
+    input  logic                icache_rlast_i,
+    input  logic                icache_rvalid_i,
+    output logic                icache_rready_o,
+
+    // D-Cache AXI4 master (ID 1)
+    output logic [         3:0] dcache_arid_o,
+    output logic [Cfg.PLEN-1:0] dcache_araddr_o,
+    output logic [         7:0] dcache_arlen_o,
+    output logic [         2:0] dcache_arsize_o,
+    output logic [         1:0] dcache_arburst_o,
+    output logic                dcache_arvalid_o,
+    input  logic                dcache_arready_i,
+
+    input  logic [         3:0] dcache_rid_i,
+    input  logic [        63:0] dcache_rdata_i,
+    input  logic [         1:0] dcache_rresp_i,
+    input  logic                dcache_rlast_i,
+    input  logic                dcache_rvalid_i,
+    output logic                dcache_rready_o,
+
+    output logic [         3:0] dcache_awid_o,
+    output logic [Cfg.PLEN-1:0] dcache_awaddr_o,
+    output logic [         7:0] dcache_awlen_o,
+    output logic [         2:0] dcache_awsize_o,
+    output logic [         1:0] dcache_awburst_o,
+    output logic                dcache_awvalid_o,
+    input  logic                dcache_awready_i,
+
+    output logic [        63:0] dcache_wdata_o,
+    output logic [         7:0] dcache_wstrb_o,
+    output logic                dcache_wlast_o,
+    output logic                dcache_wvalid_o,
+    input  logic                dcache_wready_i,
+
+    input  logic [         3:0] dcache_bid_i,
+    input  logic [         1:0] dcache_bresp_i,
+    input  logic                dcache_bvalid_i,
+    output logic                dcache_bready_o,
+`else
     // I-Cache miss/refill interface
     output logic                                  icache_miss_req_valid_o,
     input  logic                                  icache_miss_req_ready_i,
@@ -42,6 +94,7 @@ module tb_triathlon #(
     input  logic                             dcache_wb_req_ready_i,
     output logic [             Cfg.PLEN-1:0] dcache_wb_req_paddr_o,
     output logic [Cfg.DCACHE_LINE_WIDTH-1:0] dcache_wb_req_data_o,
+`endif
 
     // Expose commit signals for test
     output logic [Cfg.NRET-1:0]                commit_valid_o,
@@ -57,10 +110,32 @@ module tb_triathlon #(
     output logic                               dbg_fe_ready_o,
     output logic [Cfg.PLEN-1:0]                dbg_fe_pc_o,
     output logic [Cfg.INSTR_PER_FETCH-1:0][Cfg.ILEN-1:0] dbg_fe_instrs_o,
+    output logic                               dbg_ifu_req_valid_o,
+    output logic                               dbg_ifu_req_ready_o,
+    output logic [Cfg.PLEN-1:0]                dbg_ifu_req_addr_o,
     output logic                               dbg_dec_valid_o,
     output logic                               dbg_dec_ready_o,
     output logic                               dbg_rob_ready_o,
 
+    // Debug (uop lifecycle by ROB index; issue lanes alu0..3, bru, lsu, csr;
+    // writeback lanes in fu_valid order alu0, alu1, bru, lsu, alu2, alu3, csr)
+    output logic [Cfg.INSTR_PER_FETCH-1:0]      dbg_disp_valid_o,
+    output logic [Cfg.INSTR_PER_FETCH-1:0][7:0] dbg_disp_rob_idx_o,
+    output logic [6:0]                         dbg_issue_valid_o,
+    output logic [6:0][7:0]                    dbg_issue_rob_idx_o,
+    output logic [6:0]                         dbg_wb_valid_o,
+    output logic [6:0][7:0]                    dbg_wb_rob_idx_o,
+
+    // Debug (occupancy: ibuffer entries, ALU/BRU RS busy slots, and the
+    // configured depths the histograms are sized from)
+    output logic [$clog2(Cfg.IB_DEPTH):0]      dbg_ibuf_count_o,
+    output logic [Cfg.RS_DEPTH-1:0]            dbg_alu_rs_busy_o,
+    output logic [Cfg.RS_DEPTH-1:0]            dbg_bru_rs_busy_o,
+    output logic [15:0]                        dbg_rob_depth_o,
+    output logic [15:0]                        dbg_sb_depth_o,
+    output logic [15:0]                        dbg_ibuf_depth_o,
+    output logic [15:0]                        dbg_rs_depth_o,
+
     // Debug (LSU load path)
     output logic                               dbg_lsu_ld_req_valid_o,
     output logic                               dbg_lsu_ld_req_ready_o,
@@ -96,12 +171,19 @@ module tb_triathlon #(
     output logic [Cfg.PLEN-1:0]                dbg_sb_dcache_req_addr_o,
     output logic [Cfg.XLEN-1:0]                dbg_sb_dcache_req_data_o,
 
+    // Debug (L1 miss requests, in either MEM_IF build)
+    output logic                               dbg_icache_miss_valid_o,
+    output logic                               dbg_icache_miss_ready_o,
+    output logic [Cfg.PLEN-1:0]                dbg_icache_miss_paddr_o,
+    output logic                               dbg_dcache_miss_valid_o,
+    output logic                               dbg_dcache_miss_ready_o,
+
     // Debug (ROB head / count)
     output logic [$bits(decode_pkg::fu_e)-1:0] dbg_rob_head_fu_o,
     output logic                               dbg_rob_head_complete_o,
     output logic                               dbg_rob_head_is_store_o,
     output logic [Cfg.PLEN-1:0]                dbg_rob_head_pc_o,
-    output logic [6:0]                         dbg_rob_count_o,
+    output logic [ROB_IDX_W:0]                 dbg_rob_count_o,
     output logic [ROB_IDX_W-1:0]               dbg_rob_head_ptr_o,
     output logic [ROB_IDX_W-1:0]               dbg_rob_tail_ptr_o,
     output logic                               dbg_rob_q2_valid_o,
@@ -112,7 +194,7 @@ module tb_triathlon #(
     output logic [Cfg.PLEN-1:0]                dbg_rob_q2_pc_o,
 
     // Debug (Store Buffer head / count)
-    output logic [4:0]                         dbg_sb_count_o,
+    output logic [SB_IDX_W:0]                  dbg_sb_count_o,
     output logic [3:0]                         dbg_sb_head_ptr_o,
     output logic [3:0]                         dbg_sb_tail_ptr_o,
     output logic                               dbg_sb_head_valid_o,
@@ -169,7 +251,17 @@ module tb_triathlon #(
     output logic [63:0]                        perf_dcache_wb_req_cycles_o,
     output logic [63:0]                        perf_dcache_miss_req_cycles_o,
     output logic [63:0]                        perf_dcache_wait_refill_cycles_o,
-    output logic [63:0]                        perf_dcache_resp_cycles_o
+    output logic [63:0]                        perf_dcache_resp_cycles_o,
+    output logic [63:0]                        perf_td_retire_slots_o,
+    output logic [63:0]                        perf_td_badspec_slots_o,
+    output logic [63:0]                        perf_td_fe_icache_slots_o,
+    output logic [63:0]                        perf_td_fe_other_slots_o,
+    output logic [63:0]                        perf_td_be_mem_slots_o,
+    output logic [63:0]                        perf_td_be_alu_slots_o,
+    output logic [63:0]                        perf_td_be_bru_slots_o,
+    output logic [63:0]                        perf_td_be_mdu_slots_o,
+    output logic [63:0]                        perf_td_be_csr_slots_o,
+    output logic [63:0]                        perf_td_be_other_slots_o
 );
 
   // localparams provided via module parameters
@@ -201,6 +293,149 @@ module tb_triathlon #(
   localparam logic [2:0] DCACHE_S_WAIT_REFILL = 3'd5;
   localparam logic [2:0] DCACHE_S_RESP = 3'd6;
 
+`ifdef NPC_AXI
+  // Miss/refill handshakes between the core and the AXI masters; they keep
+  // the port names of the refill build so the counters below read the same.
+  logic                                  icache_miss_req_valid_o;
+  logic                                  icache_miss_req_ready_i;
+  logic [                  Cfg.PLEN-1:0] icache_miss_req_paddr_o;
+  logic [Cfg.ICACHE_SET_ASSOC_WIDTH-1:0] icache_miss_req_victim_way_o;
+  logic [    Cfg.ICACHE_INDEX_WIDTH-1:0] icache_miss_req_index_o;
+
+  logic                                  icache_refill_valid_i;
+  logic                                  icache_refill_ready_o;
+  logic [                  Cfg.PLEN-1:0] icache_refill_paddr_i;
+  logic [Cfg.ICACHE_SET_ASSOC_WIDTH-1:0] icache_refill_way_i;
+  logic [     Cfg.ICACHE_LINE_WIDTH-1:0] icache_refill_data_i;
+
+  logic                                  dcache_miss_req_valid_o;
+  logic                                  dcache_miss_req_ready_i;
+  logic [                  Cfg.PLEN-1:0] dcache_miss_req_paddr_o;
+  logic [Cfg.DCACHE_SET_ASSOC_WIDTH-1:0] dcache_miss_req_victim_way_o;
+  logic [    Cfg.DCACHE_INDEX_WIDTH-1:0] dcache_miss_req_index_o;
+
+  logic                                  dcache_refill_valid_i;
+  logic                                  dcache_refill_ready_o;
+  logic [                  Cfg.PLEN-1:0] dcache_refill_paddr_i;
+  logic [Cfg.DCACHE_SET_ASSOC_WIDTH-1:0] dcache_refill_way_i;
+  logic [     Cfg.DCACHE_LINE_WIDTH-1:0] dcache_refill_data_i;
+
+  logic                                  dcache_wb_req_valid_o;
+  logic                                  dcache_wb_req_ready_i;
+  logic [                  Cfg.PLEN-1:0] dcache_wb_req_paddr_o;
+  logic [     Cfg.DCACHE_LINE_WIDTH-1:0] dcache_wb_req_data_o;
+
+  icache_axi_master #(
+      .Cfg           (global_config_pkg::Cfg),
+      .AXI_ID_WIDTH  (4),
+      .AXI_DATA_WIDTH(64),
+      .AXI_ADDR_WIDTH(Cfg.PLEN),
+      .AXI_ID        (4'd0)
+  ) u_icache_axi (
+      .clk_i,
+      .rst_ni,
+
+      .miss_req_valid_i     (icache_miss_req_valid_o),
+      .miss_req_ready_o     (icache_miss_req_ready_i),
+      .miss_req_paddr_i     (icache_miss_req_paddr_o),
+      .miss_req_victim_way_i(icache_miss_req_victim_way_o),
+
+      .refill_valid_o(icache_refill_valid_i),
+      .refill_ready_i(icache_refill_ready_o),
+      .refill_paddr_o(icache_refill_paddr_i),
+      .refill_way_o  (icache_refill_way_i),
+      .refill_data_o (icache_refill_data_i),
+
+      .arid_o   (icache_arid_o),
+      .araddr_o (icache_araddr_o),
+      .arlen_o  (icache_arlen_o),
+      .arsize_o (icache_arsize_o),
+      .arburst_o(icache_arburst_o),
+      .arlock_o (),
+      .arcache_o(),
+      .arprot_o (),
+      .arqos_o  (),
+      .arvalid_o(icache_arvalid_o),
+      .arready_i(icache_arready_i),
+
+      .rid_i   (icache_rid_i),
+      .rdata_i (icache_rdata_i),
+      .rresp_i (icache_rresp_i),
+      .rlast_i (icache_rlast_i),
+      .rvalid_i(icache_rvalid_i),
+      .rready_o(icache_rready_o)
+  );
+
+  dcache_axi_master #(
+      .Cfg           (global_config_pkg::Cfg),
+      .AXI_ID_WIDTH  (4),
+      .AXI_DATA_WIDTH(64),
+      .AXI_ADDR_WIDTH(Cfg.PLEN),
+      .AXI_ID        (4'd1)
+  ) u_dcache_axi (
+      .clk_i,
+      .rst_ni,
+
+      .miss_req_valid_i     (dcache_miss_req_valid_o),
+      .miss_req_ready_o     (dcache_miss_req_ready_i),
+      .miss_req_paddr_i     (dcache_miss_req_paddr_o),
+      .miss_req_victim_way_i(dcache_miss_req_victim_way_o),
+
+      .refill_valid_o(dcache_refill_valid_i),
+      .refill_ready_i(dcache_refill_ready_o),
+      .refill_paddr_o(dcache_refill_paddr_i),
+      .refill_way_o  (dcache_refill_way_i),
+      .refill_data_o (dcache_refill_data_i),
+
+      .wb_req_valid_i(dcache_wb_req_valid_o),
+      .wb_req_ready_o(dcache_wb_req_ready_i),
+      .wb_req_paddr_i(dcache_wb_req_paddr_o),
+      .wb_req_data_i (dcache_wb_req_data_o),
+
+      .arid_o   (dcache_arid_o),
+      .araddr_o (dcache_araddr_o),
+      .arlen_o  (dcache_arlen_o),
+      .arsize_o (dcache_arsize_o),
+      .arburst_o(dcache_arburst_o),
+      .arlock_o (),
+      .arcache_o(),
+      .arprot_o (),
+      .arqos_o  (),
+      .arvalid_o(dcache_arvalid_o),
+      .arready_i(dcache_arready_i),
+
+      .rid_i   (dcache_rid_i),
+      .rdata_i (dcache_rdata_i),
+      .rresp_i (dcache_rresp_i),
+      .rlast_i (dcache_rlast_i),
+      .rvalid_i(dcache_rvalid_i),
+      .rready_o(dcache_rready_o),
+
+      .awid_o   (dcache_awid_o),
+      .awaddr_o (dcache_awaddr_o),
+      .awlen_o  (dcache_awlen_o),
+      .awsize_o (dcache_awsize_o),
+      .awburst_o(dcache_awburst_o),
+      .awlock_o (),
+      .awcache_o(),
+      .awprot_o (),
+      .awqos_o  (),
+      .awvalid_o(dcache_awvalid_o),
+      .awready_i(dcache_awready_i),
+
+      .wdata_o (dcache_wdata_o),
+      .wstrb_o (dcache_wstrb_o),
+      .wlast_o (dcache_wlast_o),
+      .wvalid_o(dcache_wvalid_o),
+      .wready_i(dcache_wready_i),
+
+      .bid_i   (dcache_bid_i),
+      .bresp_i (dcache_bresp_i),
+      .bvalid_i(dcache_bvalid_i),
+      .bready_o(dcache_bready_o)
+  );
+`endif
+
   triathlon #(
       .Cfg(global_config_pkg::Cfg)
   ) dut (
@@ -251,10 +486,46 @@ module tb_triathlon #(
   assign dbg_fe_ready_o = dut.fe_ibuf_ready;
   assign dbg_fe_pc_o    = dut.fe_ibuf_pc;
   assign dbg_fe_instrs_o = dut.fe_ibuf_instrs;
+  assign dbg_ifu_req_valid_o = dut.u_frontend.ifu2icache_req_handshake.valid;
+  assign dbg_ifu_req_ready_o = dut.u_frontend.ifu2icache_req_handshake.ready;
+  assign dbg_ifu_req_addr_o  = dut.u_frontend.ifu2icache_req_addr[Cfg.PLEN-1:0];
   assign dbg_dec_valid_o = dut.u_backend.decode_ibuf_valid;
   assign dbg_dec_ready_o = dut.u_backend.decode_ibuf_ready;
   assign dbg_rob_ready_o = dut.u_backend.rob_ready;
 
+  // Debug: uop lifecycle (dispatch / issue / writeback)
+  assign dbg_disp_valid_o = dut.u_backend.rob_dispatch_valid;
+  always_comb begin
+    for (int i = 0; i < Cfg.INSTR_PER_FETCH; i++) begin
+      dbg_disp_rob_idx_o[i] = 8'(dut.u_backend.rob_dispatch_rob_index[i]);
+    end
+  end
+  assign dbg_issue_valid_o = {
+    dut.u_backend.csr_en, dut.u_backend.lsu_en, dut.u_backend.bru_en,
+    dut.u_backend.alu3_en, dut.u_backend.alu2_en, dut.u_backend.alu1_en,
+    dut.u_backend.alu0_en
+  };
+  assign dbg_issue_rob_idx_o = {
+    8'(dut.u_backend.csr_dst), 8'(dut.u_backend.lsu_dst), 8'(dut.u_backend.bru_dst),
+    8'(dut.u_backend.alu3_dst), 8'(dut.u_backend.alu2_dst), 8'(dut.u_backend.alu1_dst),
+    8'(dut.u_backend.alu0_dst)
+  };
+  assign dbg_wb_valid_o = dut.u_backend.fu_valid;
+  always_comb begin
+    for (int i = 0; i < 7; i++) begin
+      dbg_wb_rob_idx_o[i] = 8'(dut.u_backend.fu_rob_idx[i]);
+    end
+  end
+
+  // Debug: occupancy
+  assign dbg_ibuf_count_o  = dut.u_backend.u_ibuffer.count_q;
+  assign dbg_alu_rs_busy_o = dut.u_backend.u_issue_alu.u_rs.busy;
+  assign dbg_bru_rs_busy_o = dut.u_backend.u_issue_bru.u_rs.busy;
+  assign dbg_rob_depth_o   = 16'(ROB_DEPTH);
+  assign dbg_sb_depth_o    = 16'(SB_DEPTH);
+  assign dbg_ibuf_depth_o  = 16'(Cfg.IB_DEPTH);
+  assign dbg_rs_depth_o    = 16'(Cfg.RS_DEPTH);
+
   // Debug: LSU load path
   assign dbg_lsu_ld_req_valid_o = dut.u_backend.lsu_ld_req_valid;
   assign dbg_lsu_ld_req_ready_o = dut.u_backend.lsu_ld_req_ready;
@@ -336,6 +607,12 @@ module tb_triathlon #(
   assign dbg_sb_dcache_req_addr_o  = dut.u_backend.sb_dcache_req_addr;
   assign dbg_sb_dcache_req_data_o  = dut.u_backend.sb_dcache_req_data;
 
+  assign dbg_icache_miss_valid_o = icache_miss_req_valid_o;
+  assign dbg_icache_miss_ready_o = icache_miss_req_ready_i;
+  assign dbg_icache_miss_paddr_o = icache_miss_req_paddr_o;
+  assign dbg_dcache_miss_valid_o = dcache_miss_req_valid_o;
+  assign dbg_dcache_miss_ready_o = dcache_miss_req_ready_i;
+
   // Debug: ROB head state
   assign dbg_rob_head_fu_o       = dut.u_backend.u_rob.rob_ram[dut.u_backend.u_rob.head_ptr_q].fu_type;
   assign dbg_rob_head_complete_o = dut.u_backend.u_rob.rob_ram[dut.u_backend.u_rob.head_ptr_q].complete;
@@ -417,6 +694,62 @@ module tb_triathlon #(
     end
   end
 
+  // Top-down slot accounting: each cycle, every one of the NRET retire slots
+  // goes to exactly one bucket, so the perf_td_* counters sum to
+  // NRET * cycles. Unused slots are charged to whatever holds up the oldest
+  // unretired instruction: a flush and the refill after it (bad
+  // speculation), an empty ROB (frontend), or an incomplete ROB entry
+  // (backend, split by its FU).
+  localparam logic [3:0] TD_BADSPEC = 4'd0;
+  localparam logic [3:0] TD_FE_ICACHE = 4'd1;
+  localparam logic [3:0] TD_FE_OTHER = 4'd2;
+  localparam logic [3:0] TD_BE_MEM = 4'd3;
+  localparam logic [3:0] TD_BE_ALU = 4'd4;
+  localparam logic [3:0] TD_BE_BRU = 4'd5;
+  localparam logic [3:0] TD_BE_MDU = 4'd6;
+  localparam logic [3:0] TD_BE_CSR = 4'd7;
+  localparam logic [3:0] TD_BE_OTHER = 4'd8;
+
+  logic [2:0] td_idle_slots;
+  logic [ROB_IDX_W-1:0] td_block_idx;
+  logic td_rob_drained;
+  logic td_recover_q;
+  logic [3:0] td_bucket;
+
+  assign td_idle_slots = 3'(Cfg.NRET) - commit_count;
+  assign td_block_idx = dut.u_backend.u_rob.head_ptr_q + ROB_IDX_W'(commit_count);
+  assign td_rob_drained = (dut.u_backend.u_rob.count_q <= 7'(commit_count));
+
+  always_comb begin
+    td_bucket = TD_BE_OTHER;
+    if (backend_flush_o || (td_recover_q && td_rob_drained)) begin
+      td_bucket = TD_BADSPEC;
+    end else if (td_rob_drained) begin
+      td_bucket = (icache_state == ICACHE_S_MISS_REQ || icache_state == ICACHE_S_MISS_WAIT)
+                  ? TD_FE_ICACHE : TD_FE_OTHER;
+    end else if (!dut.u_backend.u_rob.rob_ram[td_block_idx].complete) begin
+      unique case (dut.u_backend.u_rob.rob_ram[td_block_idx].fu_type)
+        FU_LSU: td_bucket = TD_BE_MEM;
+        FU_ALU: td_bucket = TD_BE_ALU;
+        FU_BRANCH: td_bucket = TD_BE_BRU;
+        FU_MUL, FU_DIV: td_bucket = TD_BE_MDU;
+        FU_CSR: td_bucket = TD_BE_CSR;
+        default: td_bucket = TD_BE_OTHER;
+      endcase
+    end
+  end
+
+  // Set by a flush until the first refetched instruction reaches the ROB.
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      td_recover_q <= 1'b0;
+    end else if (backend_flush_o) begin
+      td_recover_q <= 1'b1;
+    end else if (dut.u_backend.u_rob.count_q != '0) begin
+      td_recover_q <= 1'b0;
+    end
+  end
+
   always_ff @(posedge clk_i or negedge rst_ni) begin
     if (!rst_ni) begin
       perf_cycles_o <= 64'd0;
@@ -459,6 +792,16 @@ module tb_triathlon #(
       perf_dcache_miss_req_cycles_o <= 64'd0;
       perf_dcache_wait_refill_cycles_o <= 64'd0;
       perf_dcache_resp_cycles_o <= 64'd0;
+      perf_td_retire_slots_o <= 64'd0;
+      perf_td_badspec_slots_o <= 64'd0;
+      perf_td_fe_icache_slots_o <= 64'd0;
+      perf_td_fe_other_slots_o <= 64'd0;
+      perf_td_be_mem_slots_o <= 64'd0;
+      perf_td_be_alu_slots_o <= 64'd0;
+      perf_td_be_bru_slots_o <= 64'd0;
+      perf_td_be_mdu_slots_o <= 64'd0;
+      perf_td_be_csr_slots_o <= 64'd0;
+      perf_td_be_other_slots_o <= 64'd0;
     end else begin
       perf_cycles_o <= perf_cycles_o + 1;
       if (|commit_valid_o) begin
@@ -564,6 +907,20 @@ module tb_triathlon #(
         DCACHE_S_RESP: perf_dcache_resp_cycles_o <= perf_dcache_resp_cycles_o + 1;
         default: ;
       endcase
+
+      perf_td_retire_slots_o <= perf_td_retire_slots_o + 64'(commit_count);
+      unique case (td_bucket)
+        TD_BADSPEC: perf_td_badspec_slots_o <= perf_td_badspec_slots_o + 64'(td_idle_slots);
+        TD_FE_ICACHE: perf_td_fe_icache_slots_o <= perf_td_fe_icache_slots_o + 64'(td_idle_slots);
+        TD_FE_OTHER: perf_td_fe_other_slots_o <= perf_td_fe_other_slots_o + 64'(td_idle_slots);
+        TD_BE_MEM: perf_td_be_mem_slots_o <= perf_td_be_mem_slots_o + 64'(td_idle_slots);
+        TD_BE_ALU: perf_td_be_alu_slots_o <= perf_td_be_alu_slots_o + 64'(td_idle_slots);
+        TD_BE_BRU: perf_td_be_bru_slots_o <= perf_td_be_bru_slots_o + 64'(td_idle_slots);
+        TD_BE_MDU: perf_td_be_mdu_slots_o <= perf_td_be_mdu_slots_o + 64'(td_idle_slots);
+        TD_BE_CSR: perf_td_be_csr_slots_o <= perf_td_be_csr_slots_o + 64'(td_idle_slots);
+        TD_BE_OTHER: perf_td_be_other_slots_o <= perf_td_be_other_slots_o + 64'(td_idle_slots);
+        default: ;
+      endcase
     end
   end
 